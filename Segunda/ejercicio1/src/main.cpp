@@ -1,32 +1,7 @@
 /* Ejercicio 1: Generador de números pseudoaleatorios con ESP32 */
 #include "SPIFFS.h"
 #include <cstdint>
-
-class MiRandom {
-private:
-    uint64_t multiplicador;
-    uint64_t incremento;
-    uint64_t modulo;
-    uint64_t estado;
-
-public:
-    MiRandom(uint64_t semilla = 1) {
-        multiplicador = 1103515245;
-        incremento = 12345;  // Cambiado a valor estándar
-        modulo = (1ULL << 31);
-        estado = semilla;
-    }
-
-    void seed(uint64_t nuevaSemilla) {
-        estado = nuevaSemilla;
-    }
-
-    double rand(double min, double max) {
-        estado = (multiplicador * estado + incremento) % modulo;
-        double normalizado = (double)estado / (double)modulo;
-        return min + normalizado * (max - min);
-    }
-};
+#include "mi_random.h"
 
 //Creamos un generador global
 MiRandom generador(903699);
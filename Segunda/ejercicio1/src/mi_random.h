@@ -0,0 +1,231 @@
+// generador congruencial lineal del ejercicio 1
+// x(n+1) = (1103515245 * x(n) + 12345) mod 2^31
+// se puede incluir en la placa y en programas del pc (solo usa <cstdint>)
+
+#ifndef MI_RANDOM_H
+#define MI_RANDOM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//en el pc con x86 se usan 8 carriles AVX2 si la cpu los tiene
+#if !defined(ARDUINO) && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define MIRANDOM_AVX2 1
+#include <immintrin.h>
+#endif
+
+class MiRandom {
+private:
+    uint64_t multiplicador;
+    uint64_t incremento;
+    uint64_t modulo;
+    uint64_t estado;
+
+    //generador con otro paso (el de k pasos seguidos, para leapfrog)
+    MiRandom(uint64_t semilla, uint64_t mult, uint64_t inc) : MiRandom(semilla) {
+        multiplicador = mult;
+        incremento = inc;
+    }
+
+    //siguiente estado con mascara en vez de % (el modulo es potencia de 2)
+    uint32_t siguiente() {
+        estado = (multiplicador * estado + incremento) & (modulo - 1);
+        return (uint32_t)estado;
+    }
+
+    //rellenar con carriles intercalados: el carril j lleva x(i+j) y salta de
+    //CARRILES en CARRILES con (A, C) = CARRILES pasos seguidos. Asi no hay que
+    //esperar a cada multiplicacion y sale en el mismo orden que uno a uno.
+    //`convertir` recibe (posicion, estado). Devuelve cuantos ha hecho.
+    template <size_t CARRILES, typename Convertir>
+    size_t rellenarCarriles(size_t n, Convertir convertir) {
+        if (n < 2 * CARRILES) {
+            return 0;
+        }
+        uint32_t x[CARRILES];
+        for (size_t j = 0; j < CARRILES; j++) {
+            x[j] = siguiente();
+            convertir(j, x[j]);
+        }
+        uint64_t A, C;
+        pasos(CARRILES, multiplicador, incremento, A, C);
+        const uint32_t a = (uint32_t)A, c = (uint32_t)C, mascara = (uint32_t)(modulo - 1);
+        size_t i = CARRILES;
+        for (; i + CARRILES <= n; i += CARRILES) {
+            for (size_t j = 0; j < CARRILES; j++) {
+                //los 32 bits bajos del producto bastan para los 31 del modulo
+                x[j] = (a * x[j] + c) & mascara;
+                convertir(i + j, x[j]);
+            }
+        }
+        estado = x[CARRILES - 1];
+        return i;
+    }
+
+#ifdef MIRANDOM_AVX2
+    static bool tieneAVX2() {
+        static const bool tiene = __builtin_cpu_supports("avx2");
+        return tiene;
+    }
+
+    //lo mismo con los 8 carriles en un registro AVX2; salida en enteros o en
+    //double (dobles != nullptr) con la misma cuenta que rand()
+    __attribute__((target("avx2")))
+    size_t rellenarAVX2(uint32_t* enteros, double* dobles, size_t n, double min, double rango) {
+        if (n < 16) {
+            return 0;
+        }
+        alignas(32) uint32_t primeros[8];
+        for (size_t j = 0; j < 8; j++) {
+            primeros[j] = siguiente();
+        }
+        uint64_t A, C;
+        pasos(8, multiplicador, incremento, A, C);
+        const __m256i a = _mm256_set1_epi32((int)A);
+        const __m256i c = _mm256_set1_epi32((int)C);
+        const __m256i mascara = _mm256_set1_epi32((int)(modulo - 1));
+        //dividir entre 2^31 es exacto igual que multiplicar por 2^-31
+        const __m256d escala = _mm256_set1_pd(1.0 / (double)modulo);
+        const __m256d vmin = _mm256_set1_pd(min);
+        const __m256d vrango = _mm256_set1_pd(rango);
+        __m256i x = _mm256_load_si256((const __m256i*)primeros);
+        size_t i = 0;
+        for (;;) {
+            if (dobles != nullptr) {
+                //x < 2^31 cabe en int32 con signo: conversion directa
+                const __m256d bajo = _mm256_cvtepi32_pd(_mm256_castsi256_si128(x));
+                const __m256d alto = _mm256_cvtepi32_pd(_mm256_extracti128_si256(x, 1));
+                _mm256_storeu_pd(dobles + i, _mm256_add_pd(vmin, _mm256_mul_pd(_mm256_mul_pd(bajo, escala), vrango)));
+                _mm256_storeu_pd(dobles + i + 4, _mm256_add_pd(vmin, _mm256_mul_pd(_mm256_mul_pd(alto, escala), vrango)));
+            } else {
+                _mm256_storeu_si256((__m256i*)(enteros + i), x);
+            }
+            i += 8;
+            if (i + 8 > n) {
+                break;
+            }
+            x = _mm256_and_si256(_mm256_add_epi32(_mm256_mullo_epi32(x, a), c), mascara);
+        }
+        estado = (uint32_t)_mm256_extract_epi32(x, 7);
+        return i;
+    }
+#endif
+
+public:
+    MiRandom(uint64_t semilla = 1) {
+        multiplicador = 1103515245;
+        incremento = 12345;  // Cambiado a valor estándar
+        modulo = (1ULL << 31);
+        estado = semilla;
+    }
+
+    void seed(uint64_t nuevaSemilla) {
+        estado = nuevaSemilla;
+    }
+
+    double rand(double min, double max) {
+        estado = (multiplicador * estado + incremento) % modulo;
+        double normalizado = (double)estado / (double)modulo;
+        return min + normalizado * (max - min);
+    }
+
+    //n numeros de golpe, los mismos y en el mismo orden que n llamadas a
+    //rand(min, max) / al estado que dejan (31 bits)
+    void fill(double* salida, size_t n, double min, double max) {
+        const double rango = max - min;
+        size_t i = 0;
+#ifdef MIRANDOM_AVX2
+        if (tieneAVX2()) {
+            i = rellenarAVX2(nullptr, salida, n, min, rango);
+        }
+#endif
+        if (i == 0) {
+            const double divisor = (double)modulo;
+            i = rellenarCarriles<4>(n, [&](size_t k, uint32_t x) {
+                salida[k] = min + ((double)x / divisor) * rango;
+            });
+        }
+        for (; i < n; i++) {
+            salida[i] = min + ((double)siguiente() / (double)modulo) * rango;
+        }
+    }
+
+    void fillU32(uint32_t* salida, size_t n) {
+        size_t i = 0;
+#ifdef MIRANDOM_AVX2
+        if (tieneAVX2()) {
+            i = rellenarAVX2(salida, nullptr, n, 0.0, 0.0);
+        }
+#endif
+        if (i == 0) {
+            i = rellenarCarriles<4>(n, [&](size_t k, uint32_t x) { salida[k] = x; });
+        }
+        for (; i < n; i++) {
+            salida[i] = siguiente();
+        }
+    }
+
+    //aplicar n pasos seguidos es otra funcion afin x -> A*x + C (mod m):
+    //se calcula por cuadrados, como una potencia, en O(log n)
+    //(a,c) compuesto consigo mismo = (a*a, a*c + c)
+    static void pasos(uint64_t n, uint64_t mult, uint64_t inc, uint64_t& A, uint64_t& C) {
+        //mod 2^31 se puede operar en 64 bits y recortar al final, el
+        //desbordamiento de 2^64 no cambia los 31 bits de abajo
+        A = 1;
+        C = 0;
+        while (n > 0) {
+            if (n & 1) {
+                A = A * mult;
+                C = C * mult + inc;
+            }
+            inc = (mult + 1) * inc;
+            mult = mult * mult;
+            n >>= 1;
+        }
+        A &= (1ULL << 31) - 1;
+        C &= (1ULL << 31) - 1;
+    }
+
+    //avanza n numeros sin generarlos: igual que llamar n veces a rand()
+    void saltar(uint64_t n) {
+        uint64_t A, C;
+        pasos(n, multiplicador, incremento, A, C);
+        estado = (A * estado + C) % modulo;
+    }
+
+    //k generadores para trozos seguidos de la secuencia: el i-esimo empieza
+    //donde acabaria el anterior tras `porTrozo` numeros. Un trozo por hilo y
+    //pegando las salidas en orden sale la secuencia original.
+    std::vector<MiRandom> split(size_t k, uint64_t porTrozo) const {
+        std::vector<MiRandom> trozos;
+        MiRandom actual = *this;
+        for (size_t i = 0; i < k; i++) {
+            trozos.push_back(actual);
+            actual.saltar(porTrozo);
+        }
+        return trozos;
+    }
+
+    //k generadores intercalados: el i-esimo da los numeros i, i+k, i+2k...
+    //(cada uno avanza k pasos por llamada). Repartiendo por turnos sale la
+    //secuencia original.
+    std::vector<MiRandom> leapfrog(size_t k) const {
+        uint64_t A, C;
+        pasos(k, multiplicador, incremento, A, C);
+        //el periodo es 2^31 (c impar, a = 1 mod 4): retroceder es saltar
+        //hacia delante lo que falta para dar la vuelta. El i-esimo se deja
+        //k-1-i pasos antes de su primer numero.
+        const uint64_t periodo = modulo;
+        std::vector<MiRandom> salto;
+        for (size_t i = 0; i < k; i++) {
+            MiRandom actual = *this;
+            actual.saltar((periodo + i + 1 - k % periodo) % periodo);
+            salto.push_back(MiRandom(actual.estado, A, C));
+        }
+        return salto;
+    }
+};
+
+#endif //MI_RANDOM_H
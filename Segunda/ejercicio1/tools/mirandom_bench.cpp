@@ -0,0 +1,69 @@
+/* Programa para el pc: compara rand() uno a uno con fill() y fillU32()
+ * (carriles intercalados, AVX2 si la cpu lo tiene) y comprueba que dan
+ * exactamente los mismos numeros.
+ *
+ * Build (desde Segunda/ejercicio1):
+ *   g++ -std=c++17 -O2 -Isrc tools/mirandom_bench.cpp -o mirandom_bench
+ *
+ * Uso: mirandom_bench [cantidad] [repeticiones]
+ */
+
+#include "mi_random.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+template <typename Funcion>
+double medir(int repeticiones, Funcion funcion) {
+    const auto inicio = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeticiones; r++) {
+        funcion();
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t cantidad = argc > 1 ? strtoull(argv[1], nullptr, 10) : (1u << 22);
+    const int repeticiones = argc > 2 ? atoi(argv[2]) : 20;
+    const double total = (double)cantidad * repeticiones;
+
+    std::vector<double> uno(cantidad), bloque(cantidad);
+    std::vector<uint32_t> enteros(cantidad);
+
+    MiRandom a(903699), b(903699), c(903699);
+    const double tUno = medir(repeticiones, [&] {
+        for (size_t i = 0; i < cantidad; i++) {
+            uno[i] = a.rand(0.0, 1.0);
+        }
+    });
+    const double tFill = medir(repeticiones, [&] { b.fill(bloque.data(), cantidad, 0.0, 1.0); });
+    const double tU32 = medir(repeticiones, [&] { c.fillU32(enteros.data(), cantidad); });
+
+    printf("rand():    %7.1f M numeros/s\n", total / tUno / 1e6);
+    printf("fill():    %7.1f M numeros/s (x%.1f)\n", total / tFill / 1e6, tUno / tFill);
+    printf("fillU32(): %7.1f M numeros/s (x%.1f)\n", total / tU32 / 1e6, tUno / tU32);
+
+    //mismos numeros y mismo estado final
+    bool iguales = uno == bloque && a.rand(0.0, 1.0) == b.rand(0.0, 1.0);
+    MiRandom d(903699), e(903699);
+    for (size_t n : {0, 1, 7, 15, 16, 17, 33, 1000}) {
+        std::vector<double> v(n);
+        std::vector<uint32_t> w(n);
+        d.fill(v.data(), n, -3.0, 5.0);
+        for (size_t i = 0; i < n; i++) {
+            iguales = iguales && v[i] == e.rand(-3.0, 5.0);
+        }
+        MiRandom copia = e;
+        d.fillU32(w.data(), n);
+        for (size_t i = 0; i < n; i++) {
+            iguales = iguales && w[i] == (uint32_t)(copia.rand(0.0, 1.0) * 2147483648.0);
+        }
+        e = copia;
+    }
+    printf("%s\n", iguales ? "misma secuencia que rand()" : "ERROR: secuencia distinta");
+    return iguales ? 0 : 1;
+}
@@ -0,0 +1,76 @@
+/* Programa para el pc: reparte la secuencia de MiRandom entre varios hilos
+ * con split() (trozos seguidos) y leapfrog() (intercalados) y comprueba que
+ * juntando las salidas sale la misma secuencia que en serie.
+ *
+ * Build (desde Segunda/ejercicio1):
+ *   g++ -std=c++17 -O2 -pthread -Isrc tools/mirandom_paralelo.cpp -o mirandom_paralelo
+ *
+ * Uso: mirandom_paralelo [semilla] [cantidad] [hilos]
+ */
+
+#include "mi_random.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+int main(int argc, char** argv) {
+    const uint64_t semilla = argc > 1 ? strtoull(argv[1], nullptr, 10) : 903699;
+    const size_t cantidad = argc > 2 ? strtoull(argv[2], nullptr, 10) : 100000000;
+    size_t hilos = argc > 3 ? strtoull(argv[3], nullptr, 10) : std::thread::hardware_concurrency();
+    if (hilos == 0) {
+        hilos = 1;
+    }
+
+    //secuencia en serie de referencia
+    std::vector<double> serie(cantidad);
+    auto inicio = std::chrono::steady_clock::now();
+    MiRandom generador(semilla);
+    for (size_t i = 0; i < cantidad; i++) {
+        serie[i] = generador.rand(0.0, 1.0);
+    }
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    printf("serie: %zu numeros en %.3f s\n", cantidad, segundos);
+
+    //split: cada hilo escribe su trozo seguido
+    std::vector<double> trozos(cantidad);
+    const uint64_t porTrozo = (cantidad + hilos - 1) / hilos;
+    inicio = std::chrono::steady_clock::now();
+    std::vector<MiRandom> partes = MiRandom(semilla).split(hilos, porTrozo);
+    std::vector<std::thread> trabajadores;
+    for (size_t h = 0; h < hilos; h++) {
+        trabajadores.emplace_back([&, h] {
+            for (size_t i = h * porTrozo; i < cantidad && i < (h + 1) * porTrozo; i++) {
+                trozos[i] = partes[h].rand(0.0, 1.0);
+            }
+        });
+    }
+    for (auto& t : trabajadores) {
+        t.join();
+    }
+    segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    printf("split, %zu hilos: %.3f s, %s\n", hilos, segundos, trozos == serie ? "igual a la serie" : "DISTINTO");
+
+    //leapfrog: el hilo h escribe las posiciones h, h+hilos, h+2*hilos...
+    std::vector<double> intercalados(cantidad);
+    inicio = std::chrono::steady_clock::now();
+    std::vector<MiRandom> saltos = MiRandom(semilla).leapfrog(hilos);
+    trabajadores.clear();
+    for (size_t h = 0; h < hilos; h++) {
+        trabajadores.emplace_back([&, h] {
+            for (size_t i = h; i < cantidad; i += hilos) {
+                intercalados[i] = saltos[h].rand(0.0, 1.0);
+            }
+        });
+    }
+    for (auto& t : trabajadores) {
+        t.join();
+    }
+    segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    printf("leapfrog, %zu hilos: %.3f s, %s\n", hilos, segundos,
+           intercalados == serie ? "igual a la serie" : "DISTINTO");
+
+    return (trozos == serie && intercalados == serie) ? 0 : 1;
+}
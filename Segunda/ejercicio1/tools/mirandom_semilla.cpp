@@ -0,0 +1,303 @@
+/* Programa para el pc: recupera la semilla de MiRandom a partir de unos
+ * cuantos numeros de rand(0, 1) impresos con "%.6f" (los primeros que salen
+ * tras seed()).
+ *
+ * Dos formas:
+ *  - algebraica (por defecto): el primer estado x1 tiene que caer en el
+ *    intervalo de enteros que se imprime como el primer numero (unos 2^31 *
+ *    1e-6 = 2148 candidatos). Se prueba cada uno hacia delante y la semilla
+ *    sale deshaciendo un paso: s = a^-1 * (x1 - c) mod 2^31 (a es impar, asi
+ *    que tiene inverso modulo una potencia de 2).
+ *  - fuerza bruta (--fuerza-bruta): las 2^31 semillas repartidas entre hilos,
+ *    8 por registro AVX2 si la cpu lo tiene, con progreso cada segundo.
+ * Con --primera se para en cuanto aparece una semilla valida.
+ *
+ * Las semillas se dan en [0, 2^31): s y s + k*2^31 dan la misma secuencia.
+ *
+ * Build (desde Segunda/ejercicio1):
+ *   g++ -std=c++17 -O2 -pthread -Isrc tools/mirandom_semilla.cpp -o mirandom_semilla
+ *
+ * Uso: mirandom_semilla [--fuerza-bruta] [--primera] [--hilos N] v1 v2 v3 ...
+ *   p. ej. con los numeros que imprime el ejercicio para la semilla 903699
+ */
+
+#include "mi_random.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SEMILLA_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+const uint64_t kMultiplicador = 1103515245;
+const uint64_t kIncremento = 12345;
+const uint64_t kModulo = 1ULL << 31;
+const uint32_t kMascara = (uint32_t)(kModulo - 1);
+
+//estados x que rand(0, 1) imprime como el texto observado
+struct Intervalo {
+    uint32_t bajo;
+    uint32_t alto;
+};
+
+std::string imprimir(uint64_t x) {
+    char texto[32];
+    snprintf(texto, sizeof(texto), "%.6f", (double)x / (double)kModulo);
+    return texto;
+}
+
+//aproximacion con double y luego se ajustan los bordes con la misma
+//impresion que hace el ejercicio, para que el intervalo sea exacto
+bool intervaloDe(const char* texto, Intervalo& intervalo) {
+    const double valor = atof(texto);
+    if (valor < 0.0 || valor > 1.0) {
+        return false;
+    }
+    //"0.5" cuenta como "0.500000"
+    char objetivo[32];
+    snprintf(objetivo, sizeof(objetivo), "%.6f", valor);
+    int64_t bajo = (int64_t)std::floor((valor - 5e-7) * (double)kModulo) - 4;
+    int64_t alto = (int64_t)std::ceil((valor + 5e-7) * (double)kModulo) + 4;
+    bajo = std::max<int64_t>(bajo, 0);
+    alto = std::min<int64_t>(alto, (int64_t)kMascara);
+    while (bajo <= alto && imprimir((uint64_t)bajo) != objetivo) {
+        bajo++;
+    }
+    while (alto >= bajo && imprimir((uint64_t)alto) != objetivo) {
+        alto--;
+    }
+    if (bajo > alto) {
+        return false;
+    }
+    intervalo.bajo = (uint32_t)bajo;
+    intervalo.alto = (uint32_t)alto;
+    return true;
+}
+
+bool dentro(uint32_t x, const Intervalo& intervalo) {
+    return x - intervalo.bajo <= intervalo.alto - intervalo.bajo;
+}
+
+uint32_t paso(uint32_t x) {
+    return (uint32_t)((kMultiplicador * x + kIncremento) & kMascara);
+}
+
+//x1 ya esta en el primer intervalo: comprobar el resto hacia delante
+bool encajaDesde(uint32_t x1, const std::vector<Intervalo>& observados) {
+    uint32_t x = x1;
+    for (size_t i = 1; i < observados.size(); i++) {
+        x = paso(x);
+        if (!dentro(x, observados[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t inversoMultiplicador() {
+    //Newton: cada vuelta dobla los bits correctos del inverso de a impar
+    uint64_t inverso = kMultiplicador;
+    for (int i = 0; i < 5; i++) {
+        inverso *= 2 - kMultiplicador * inverso;
+    }
+    return (uint32_t)(inverso & kMascara);
+}
+
+uint32_t semillaDe(uint32_t x1) {
+    return (uint32_t)(((uint64_t)inversoMultiplicador() * (x1 - kIncremento)) & kMascara);
+}
+
+struct Busqueda {
+    std::vector<Intervalo> observados;
+    bool primera = false;
+    std::atomic<bool> parar{false};
+    std::atomic<uint64_t> probadas{0};
+    std::mutex cerrojo;
+    std::vector<uint32_t> semillas;
+
+    void encontrada(uint32_t semilla) {
+        std::lock_guard<std::mutex> bloqueo(cerrojo);
+        semillas.push_back(semilla);
+        if (primera) {
+            parar = true;
+        }
+    }
+};
+
+void algebraica(Busqueda& busqueda) {
+    const Intervalo& primero = busqueda.observados[0];
+    for (uint64_t x1 = primero.bajo; x1 <= primero.alto && !busqueda.parar; x1++) {
+        if (encajaDesde((uint32_t)x1, busqueda.observados)) {
+            busqueda.encontrada(semillaDe((uint32_t)x1));
+        }
+        busqueda.probadas++;
+    }
+}
+
+//semillas [desde, hasta): 8 a la vez, sin ramas hasta que alguna cae dentro
+void fuerzaBrutaEscalar(Busqueda& busqueda, uint32_t desde, uint32_t hasta) {
+    const Intervalo& primero = busqueda.observados[0];
+    for (uint32_t s = desde; s < hasta; s += 8) {
+        uint32_t acierto = 0;
+        for (uint32_t j = 0; j < 8; j++) {
+            acierto |= (uint32_t)dentro(paso(s + j), primero) << j;
+        }
+        while (acierto != 0) {
+            const uint32_t semilla = s + (uint32_t)__builtin_ctz(acierto);
+            if (encajaDesde(paso(semilla), busqueda.observados)) {
+                busqueda.encontrada(semilla);
+            }
+            acierto &= acierto - 1;
+        }
+    }
+}
+
+#ifdef SEMILLA_AVX2
+__attribute__((target("avx2")))
+void fuerzaBrutaAVX2(Busqueda& busqueda, uint32_t desde, uint32_t hasta) {
+    const Intervalo& primero = busqueda.observados[0];
+    const __m256i a = _mm256_set1_epi32((int)kMultiplicador);
+    const __m256i c = _mm256_set1_epi32((int)kIncremento);
+    const __m256i mascara = _mm256_set1_epi32((int)kMascara);
+    //dentro() sin signo: x - bajo <= ancho  <=>  min(x - bajo, ancho) == x - bajo
+    const __m256i bajo = _mm256_set1_epi32((int)primero.bajo);
+    const __m256i ancho = _mm256_set1_epi32((int)(primero.alto - primero.bajo));
+    const __m256i ocho = _mm256_set1_epi32(8);
+    __m256i s = _mm256_add_epi32(_mm256_set1_epi32((int)desde), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    for (uint32_t base = desde; base < hasta; base += 8) {
+        const __m256i x = _mm256_and_si256(_mm256_add_epi32(_mm256_mullo_epi32(s, a), c), mascara);
+        const __m256i d = _mm256_sub_epi32(x, bajo);
+        const __m256i si = _mm256_cmpeq_epi32(_mm256_min_epu32(d, ancho), d);
+        uint32_t acierto = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(si));
+        while (acierto != 0) {
+            const uint32_t semilla = base + (uint32_t)__builtin_ctz(acierto);
+            if (encajaDesde(paso(semilla), busqueda.observados)) {
+                busqueda.encontrada(semilla);
+            }
+            acierto &= acierto - 1;
+        }
+        s = _mm256_add_epi32(s, ocho);
+    }
+}
+#endif
+
+void fuerzaBruta(Busqueda& busqueda, unsigned hilos) {
+    //trozos de 2^20 semillas que los hilos van cogiendo
+    const uint32_t trozo = 1u << 20;
+    const uint64_t trozos = kModulo / trozo;
+    std::atomic<uint64_t> siguiente{0};
+#ifdef SEMILLA_AVX2
+    const bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+    std::vector<std::thread> trabajadores;
+    for (unsigned h = 0; h < hilos; h++) {
+        trabajadores.emplace_back([&] {
+            for (uint64_t t = siguiente++; t < trozos && !busqueda.parar; t = siguiente++) {
+                const uint32_t desde = (uint32_t)(t * trozo);
+#ifdef SEMILLA_AVX2
+                if (avx2) {
+                    fuerzaBrutaAVX2(busqueda, desde, desde + trozo);
+                } else {
+                    fuerzaBrutaEscalar(busqueda, desde, desde + trozo);
+                }
+#else
+                fuerzaBrutaEscalar(busqueda, desde, desde + trozo);
+#endif
+                busqueda.probadas += trozo;
+            }
+        });
+    }
+
+    //progreso cada segundo mientras trabajan
+    const auto inicio = std::chrono::steady_clock::now();
+    std::thread progreso([&] {
+        auto ultimo = inicio;
+        while (busqueda.probadas < kModulo && !busqueda.parar) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            const auto ahora = std::chrono::steady_clock::now();
+            if (ahora - ultimo >= std::chrono::seconds(1)) {
+                ultimo = ahora;
+                const double hecho = (double)busqueda.probadas / (double)kModulo;
+                const double segundos = std::chrono::duration<double>(ahora - inicio).count();
+                fprintf(stderr, "  %5.1f%% (%.0f M semillas/s)\n", 100.0 * hecho,
+                        (double)busqueda.probadas / segundos / 1e6);
+            }
+        }
+    });
+    for (auto& t : trabajadores) {
+        t.join();
+    }
+    busqueda.parar = true;
+    progreso.join();
+}
+
+int uso() {
+    fprintf(stderr, "uso: mirandom_semilla [--fuerza-bruta] [--primera] [--hilos N] v1 v2 v3 ...\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Busqueda busqueda;
+    bool bruta = false;
+    unsigned hilos = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<const char*> textos;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--fuerza-bruta") == 0) {
+            bruta = true;
+        } else if (strcmp(argv[i], "--primera") == 0) {
+            busqueda.primera = true;
+        } else if (strcmp(argv[i], "--hilos") == 0 && i + 1 < argc) {
+            hilos = std::max(1u, (unsigned)strtoul(argv[++i], nullptr, 10));
+        } else {
+            textos.push_back(argv[i]);
+        }
+    }
+    if (textos.empty()) {
+        return uso();
+    }
+    for (const char* texto : textos) {
+        Intervalo intervalo;
+        if (!intervaloDe(texto, intervalo)) {
+            fprintf(stderr, "'%s' no lo puede imprimir rand(0, 1) con %%.6f\n", texto);
+            return 1;
+        }
+        busqueda.observados.push_back(intervalo);
+    }
+
+    const auto inicio = std::chrono::steady_clock::now();
+    if (bruta) {
+        fuerzaBruta(busqueda, hilos);
+    } else {
+        algebraica(busqueda);
+    }
+    const double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    std::sort(busqueda.semillas.begin(), busqueda.semillas.end());
+    printf("%s: %llu candidatos en %.3f s, %zu semilla(s)\n", bruta ? "fuerza bruta" : "algebraica",
+           (unsigned long long)busqueda.probadas.load(), segundos, busqueda.semillas.size());
+    for (uint32_t semilla : busqueda.semillas) {
+        //se comprueba con el propio generador
+        MiRandom generador(semilla);
+        printf("semilla %u:", semilla);
+        for (size_t i = 0; i < textos.size(); i++) {
+            printf(" %.6f", generador.rand(0.0, 1.0));
+        }
+        printf("\n");
+    }
+    return busqueda.semillas.empty() ? 1 : 0;
+}
@@ -5,7 +5,12 @@
 #ifndef GEFFE_GENERATOR_H  //para evitar que el archivo se duplique
 #define GEFFE_GENERATOR_H  //por si no estaba definido
 
-#include <Arduino.h>  
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <cstddef>
+#include <cstdint>  //para usarlo tambien en el pc (pruebas NIST)
+#endif
 
 //==================== LFSR ====================
 //toma bits de un numero y los entremezcla y tal
@@ -116,7 +121,7 @@ public:
         bool x1 = lfsr1.next(); //Pide un bit a la máquina 2
         bool x2 = lfsr2.next(); //Pide un bit a la máquina 3
         //Fórmula del generador de Geffe - mezcla inteligente
-        return (x0 & x1) ^ (~x0 & x2);
+        return (x0 & x1) ^ (!x0 & x2);
     }
     
     //Genera un byte completo (8 bits)
@@ -0,0 +1,127 @@
+// generador de Beth-Piper con tres LFSRs
+// Beth-Piper: Zn = (x0 ∧ x1) ⊕ (x0 ∧ x2) ⊕ x2
+// donde x0, x1, x2 son bits de salida de los tres LFSRs
+
+#ifndef BETH_PIPER_GENERATOR_H
+#define BETH_PIPER_GENERATOR_H
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <cstddef>
+#include <cstdint>  //para usarlo tambien en el pc (pruebas NIST)
+#endif
+
+// clase que implementa un LFSR simple
+class LFSR {
+private:
+    uint32_t state;           // estado actual del registro
+    uint32_t feedback;        // bits de realimentacion
+    uint8_t size;             // tamaño del registro (número de bits)
+    uint32_t mask;            // máscara para el tamaño del registro
+
+public:
+    LFSR() : state(0), feedback(0), size(0), mask(0) {}
+    
+    void init(uint32_t initialState, uint32_t feedbackBits, uint8_t registerSize) {
+        size = registerSize;
+        state = initialState & ((1UL << size) - 1);  // aplicar máscara según tamaño
+        feedback = feedbackBits;
+        mask = (1UL << size) - 1;
+    }
+
+    //Genera el siguiente bit y actualiza el estado
+    bool next() {
+        //calcular bit de salida (bit menos significativo)
+        bool outputBit = state & 1;
+        
+        // calcular bit de realimentacion usando XOR de los bits marcados
+        uint32_t feedbackBit = 0;
+        uint32_t temp = state & feedback;
+        
+        // Contar paridad (XOR de todos los bits activos)
+        while (temp) {
+            feedbackBit ^= (temp & 1);
+            temp >>= 1;
+        }
+        
+        //desplazar y añadir bit de realimentación
+        state = (state >> 1) | (feedbackBit << (size - 1));
+        state &= mask;
+        
+        return outputBit;
+    }
+    
+    uint32_t getState() const { return state; }
+};
+
+//generador numero
+class BethPiper {
+private:
+    LFSR lfsr0, lfsr1, lfsr2;
+    
+    //decodificar 9 bytes en parámetros del LFSR
+    void decodeLFSRKey(const uint8_t* key, uint8_t& size, uint32_t& state, uint32_t& feedback) {
+        // primer byte: 5 bits menos significativos contienen el tamaño
+        size = key[0] & 0x1F;
+        
+        //Siguiente 4 bytes: estado inicial (little-endian)
+        state = ((uint32_t)key[1]) |
+                ((uint32_t)key[2] << 8) |
+                ((uint32_t)key[3] << 16) |
+                ((uint32_t)key[4] << 24);
+        
+        //ultimos 4 bytes: bits de realimentación (little-endian)
+        feedback = ((uint32_t)key[5]) |
+                   ((uint32_t)key[6] << 8) |
+                   ((uint32_t)key[7] << 16) |
+                   ((uint32_t)key[8] << 24);
+    }
+
+public:
+    // el constructor recibe clave de 27 bytes
+    BethPiper(const uint8_t* key) {
+        uint8_t size0, size1, size2;
+        uint32_t state0, state1, state2;
+        uint32_t feedback0, feedback1, feedback2;
+        
+        //decodificar los tres grupos de 9 bytes
+        decodeLFSRKey(&key[0], size0, state0, feedback0);   // LFSR0
+        decodeLFSRKey(&key[9], size1, state1, feedback1);   // LFSR1
+        decodeLFSRKey(&key[18], size2, state2, feedback2);  // LFSR2
+        
+        //inicializar los tres LFSRs
+        lfsr0.init(state0, feedback0, size0);
+        lfsr1.init(state1, feedback1, size1);
+        lfsr2.init(state2, feedback2, size2);
+    }
+    
+    //siguiente bit
+    //Zn = (x0 ∧ x1) ⊕ (x0 ∧ x2) ⊕ x2
+    bool next() {
+        bool x0 = lfsr0.next();
+        bool x1 = lfsr1.next();
+        bool x2 = lfsr2.next();
+        
+        //función de Beth-Piper
+        return (x0 & x1) ^ (x0 & x2) ^ x2;
+    }
+    
+    //byte completo
+    uint8_t nextByte() {
+        uint8_t result = 0;
+        for (int i = 0; i < 8; i++) {
+            result = (result << 1) | (next() ? 1 : 0);
+        }
+        return result;
+    }
+    
+    //Cifra/descifra
+    void processBuffer(uint8_t* buffer, size_t length) {
+        for (size_t i = 0; i < length; i++) {
+            buffer[i] ^= nextByte();
+        }
+    }
+};
+
+#endif
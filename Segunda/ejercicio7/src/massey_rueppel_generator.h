@@ -4,7 +4,12 @@
 #ifndef MASSEY_RUEPPEL_GENERATOR_H
 #define MASSEY_RUEPPEL_GENERATOR_H
 
+#ifdef ARDUINO
 #include <Arduino.h>
+#else
+#include <cstddef>
+#include <cstdint>  //para usarlo tambien en el pc (pruebas NIST)
+#endif
 
 //==================== LFSR ====================
 class LFSR {
@@ -0,0 +1,84 @@
+// Cifrado y descifrado de ficheros con cifradorOFB, leyendo por bloques
+// grandes que se reutilizan entre llamadas.
+//
+// Formato del fichero cifrado:
+//   "OFB1" | VI (16 bytes) | datos cifrados (mismo tamano que el original)
+// de modo que para descifrar basta la clave.
+//
+// La interfaz es la misma en la placa (SPIFFS u otro fs::FS) y en el host
+// (ficheros POSIX); solo cambia el constructor. En el host, con
+// usarHilos(n > 1), el fichero se reparte en n tramos contiguos y cada hilo
+// posiciona su propio keystream con seekByte(), lee y escribe su tramo.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CifradorOFB.h"
+
+#ifdef ARDUINO
+#include <FS.h>
+#endif
+
+class ArchivoOFB {
+public:
+    static constexpr size_t kCabecera = 4 + 16;
+#ifdef ARDUINO
+    static constexpr size_t kBufferPorDefecto = 32 * 1024;
+#else
+    static constexpr size_t kBufferPorDefecto = 1 << 20;
+#endif
+
+#ifdef ARDUINO
+    ArchivoOFB(fs::FS &fs, const std::array<uint8_t, 16> &clave,
+               size_t tamBuffer = kBufferPorDefecto);
+#else
+    explicit ArchivoOFB(const std::array<uint8_t, 16> &clave,
+                        size_t tamBuffer = kBufferPorDefecto);
+#endif
+
+    // cifrar() y descifrar() rechazan que `salida` sea el propio `entrada` y,
+    // si fallan, borran la salida a medias.
+
+    // Escribe en `salida` la cabecera con `vi` y `entrada` cifrado
+    bool cifrar(const char *entrada, const char *salida, const std::array<uint8_t, 16> &vi);
+
+    // Lee el VI de la cabecera de `entrada` y escribe el original en `salida`
+    bool descifrar(const char *entrada, const char *salida);
+
+    // Descifra `longitud` bytes del fichero cifrado a partir del byte
+    // `desplazamiento` de los datos, sin procesar lo anterior
+    bool descifrarRango(const char *archivo, uint64_t desplazamiento,
+                        uint8_t *salida, size_t longitud);
+
+    // Hilos del modo paralelo (0 = los del equipo). En la placa no tiene efecto.
+    void usarHilos(unsigned hilos);
+
+    // Descripcion del ultimo fallo (cadena vacia si no lo hubo)
+    const char *error() const { return error_; }
+
+private:
+    // Por debajo de esto por hilo no compensa repartir
+    static constexpr uint64_t kMinimoPorHilo = 256 * 1024;
+
+#ifdef ARDUINO
+    fs::FS &fs_;
+#endif
+    cifradorOFB cifrador_;
+    size_t tamBuffer_;
+    unsigned hilos_ = 1;
+    std::vector<std::vector<uint8_t>> buffers_;  // uno por hilo, se conservan
+    const char *error_ = "";
+
+    bool procesar(const char *entrada, uint64_t desdeEntrada, const char *salida,
+                  const uint8_t *cabecera, uint64_t longitud,
+                  const std::array<uint8_t, 16> &vi);
+    bool procesarArchivos(const char *entrada, uint64_t desdeEntrada, const char *salida,
+                          const uint8_t *cabecera, uint64_t longitud,
+                          const std::array<uint8_t, 16> &vi);
+    static bool mismoFichero(const char *entrada, const char *salida);
+    std::vector<uint8_t> &buffer(size_t indice);
+    bool fallo(const char *mensaje);
+};
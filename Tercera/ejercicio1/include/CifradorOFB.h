@@ -0,0 +1,75 @@
+// Cifrador OFB personalizado: cada bloque de keystream (16 bytes) es una
+// permutacion con XOR del bloque anterior y la clave (ver kPermutacion).
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class cifradorOFB {
+public:
+    static constexpr size_t kBloque = 16;
+
+    cifradorOFB(const std::array<uint8_t, 16> &clave,
+                const std::array<uint8_t, 16> &vi);
+
+    void reiniciarVI(const std::array<uint8_t, 16> &vi);
+
+    uint8_t procesarByte(uint8_t dato) {
+        if (cursor_ >= kBloque) {
+            generarSiguienteBloque();
+        }
+        // El bloque de keystream es el propio estado
+        uint8_t salida = static_cast<uint8_t>(
+            dato ^ (estado_[cursor_ / 8] >> (8 * (cursor_ % 8))));
+        ++cursor_;
+        return salida;
+    }
+
+    // Cifra/descifra `longitud` bytes de `entrada` en `salida` (pueden ser
+    // el mismo buffer). No reserva memoria: los bloques enteros se combinan
+    // como dos palabras de 64 bits y solo el principio y el final, si no
+    // caen en un limite de bloque, van byte a byte.
+    void procesar(const uint8_t *entrada, uint8_t *salida, size_t longitud);
+    void procesar(uint8_t *datos, size_t longitud) {
+        procesar(datos, datos, longitud);
+    }
+
+    std::vector<uint8_t> procesar(const std::vector<uint8_t> &datos);
+
+    // Escribe en `salida` los `bloques` bloques de keystream siguientes
+    // (16 bytes cada uno) y avanza el estado. Lo que quedara sin usar del
+    // bloque actual se descarta.
+    void generarBloques(uint8_t *salida, size_t bloques);
+
+    // Salto directo: tras seek(n) el siguiente byte procesado es el primero
+    // del bloque de keystream n (contando desde 0 tras el VI), sin generar
+    // los anteriores. seekByte() admite cualquier desplazamiento en bytes.
+    // La actualizacion del estado es afin sobre GF(2) (x -> Lx ^ c), asi que
+    // se eleva la matriz 128x128 por cuadrados: O(log n) productos.
+    void seek(uint64_t bloque);
+    void seekByte(uint64_t desplazamiento);
+
+    // Estructura de la actualizacion, para el analisis (RecuperadorClave):
+    // el bit i del bloque nuevo es la paridad de filaLineal(i) & estado
+    // (mismo orden de bits que los bytes del bloque) XOR el bit i % 8 de
+    // ~clave[indiceClave(i / 8)].
+    static void filaLineal(size_t bit, uint64_t (&fila)[2]);
+    static size_t indiceClave(size_t byteDestino);
+
+    // Implementacion elegida en tiempo de ejecucion: "ssse3", "neon" o
+    // "escalar". usarEscalar(true) fuerza la escalar (pruebas y benchmark).
+    static const char *implementacion();
+    static void usarEscalar(bool escalar);
+
+private:
+    static constexpr size_t kBloquesPorLote = 32;  // 512 bytes de pila
+
+    uint64_t constante_[2] = {};  // ~clave colocada en cada byte destino
+    uint64_t vi_[2] = {};         // VI inicial, origen de seek()
+    uint64_t estado_[2] = {};     // VI actual = ultimo bloque de keystream
+    size_t cursor_ = 0;
+
+    void generarSiguienteBloque();
+};
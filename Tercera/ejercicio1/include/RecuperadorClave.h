@@ -0,0 +1,46 @@
+// Recuperacion de la clave de cifradorOFB con texto claro conocido.
+//
+// La actualizacion del estado es afin sobre GF(2) en la clave y el VI:
+//   s_0 = VI,  s_{n+1} = L s_n ^ ~K(clave)
+// asi que cada bit de keystream conocido (claro ^ cifrado) es una ecuacion
+// lineal en las 256 incognitas (128 bits de clave y 128 de VI). El sistema
+// se reduce con eliminacion gaussiana por bloques de 8 columnas al estilo
+// M4RI (tablas con las 256 combinaciones de los pivotes del bloque), con las
+// filas empaquetadas en palabras de 64 bits.
+//
+// Con el VI de la cabecera bastan 16 bytes conocidos de un mismo bloque;
+// sin el, dos bloques consecutivos.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Bytes de texto claro conocidos a partir de `desplazamiento` de los datos
+struct FragmentoConocido {
+    uint64_t desplazamiento;
+    std::vector<uint8_t> claro;
+};
+
+struct MensajeCapturado {
+    std::vector<uint8_t> cifrado;            // datos cifrados, sin cabecera
+    bool conVI = false;                      // VI leido de la cabecera
+    std::array<uint8_t, 16> vi{};
+    std::vector<FragmentoConocido> conocidos;
+};
+
+struct ResultadoClave {
+    bool resuelta = false;      // los 128 bits de clave quedan determinados
+    bool consistente = true;    // false: el texto claro supuesto es incorrecto
+    unsigned ecuaciones = 0;
+    unsigned rango = 0;
+    std::array<uint8_t, 16> clave{};
+};
+
+ResultadoClave recuperarClave(const MensajeCapturado &mensaje);
+
+// Resuelve cada mensaje por separado, repartidos entre `hilos` hilos
+// (0 = los del equipo; en la placa se resuelven uno tras otro).
+std::vector<ResultadoClave> recuperarClaves(const std::vector<MensajeCapturado> &mensajes,
+                                            unsigned hilos = 0);
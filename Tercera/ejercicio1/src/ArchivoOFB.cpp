@@ -0,0 +1,349 @@
+#include "ArchivoOFB.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifndef ARDUINO
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <thread>
+#endif
+
+namespace {
+
+constexpr char kMagia[4] = {'O', 'F', 'B', '1'};
+
+#ifdef ARDUINO
+class Lector {
+public:
+    Lector(fs::FS &fs, const char *ruta) : archivo_(fs.open(ruta, FILE_READ)) {}
+    bool abierto() const { return static_cast<bool>(archivo_); }
+    uint64_t tamano() { return archivo_.size(); }
+    bool irA(uint64_t posicion) { return archivo_.seek(static_cast<size_t>(posicion)); }
+    size_t leer(uint8_t *datos, size_t longitud) { return archivo_.read(datos, longitud); }
+
+private:
+    File archivo_;
+};
+
+class Escritor {
+public:
+    Escritor(fs::FS &fs, const char *ruta) : archivo_(fs.open(ruta, FILE_WRITE)) {}
+    bool abierto() const { return static_cast<bool>(archivo_); }
+    bool escribir(const uint8_t *datos, size_t longitud) {
+        return archivo_.write(datos, longitud) == longitud;
+    }
+    // File::close() no informa de errores: los detecta ya escribir()
+    bool cerrar() {
+        archivo_.close();
+        return true;
+    }
+
+private:
+    File archivo_;
+};
+#else
+class Lector {
+public:
+    explicit Lector(const char *ruta) : archivo_(ruta, std::ios::binary) {}
+    bool abierto() const { return archivo_.is_open(); }
+    uint64_t tamano() {
+        archivo_.seekg(0, std::ios::end);
+        const auto fin = archivo_.tellg();
+        archivo_.seekg(0);
+        return fin < 0 ? 0 : static_cast<uint64_t>(fin);
+    }
+    bool irA(uint64_t posicion) {
+        archivo_.seekg(static_cast<std::streamoff>(posicion));
+        return static_cast<bool>(archivo_);
+    }
+    size_t leer(uint8_t *datos, size_t longitud) {
+        archivo_.read(reinterpret_cast<char *>(datos), static_cast<std::streamsize>(longitud));
+        return static_cast<size_t>(archivo_.gcount());
+    }
+
+private:
+    std::ifstream archivo_;
+};
+
+class Escritor {
+public:
+    // `existente`: abrir sin truncar para escribir un tramo (modo paralelo)
+    explicit Escritor(const char *ruta, bool existente = false)
+        : archivo_(ruta, existente ? std::ios::binary | std::ios::in | std::ios::out
+                                   : std::ios::binary | std::ios::out | std::ios::trunc) {}
+    bool abierto() const { return archivo_.is_open(); }
+    bool irA(uint64_t posicion) {
+        archivo_.seekp(static_cast<std::streamoff>(posicion));
+        return static_cast<bool>(archivo_);
+    }
+    bool escribir(const uint8_t *datos, size_t longitud) {
+        archivo_.write(reinterpret_cast<const char *>(datos), static_cast<std::streamsize>(longitud));
+        return static_cast<bool>(archivo_);
+    }
+    // false si falla el volcado pendiente o el propio cierre
+    bool cerrar() {
+        archivo_.flush();
+        const bool volcado = static_cast<bool>(archivo_);
+        archivo_.close();
+        return volcado && !archivo_.fail();
+    }
+
+private:
+    std::fstream archivo_;
+};
+#endif
+
+// Cifra `longitud` bytes de `entrada` a `salida` a traves de `buffer`.
+// Devuelve nullptr o la descripcion del fallo.
+const char *procesarTramo(Lector &entrada, Escritor &salida, cifradorOFB &cifrador,
+                          std::vector<uint8_t> &buffer, uint64_t longitud) {
+    while (longitud > 0) {
+        const size_t pedir = static_cast<size_t>(std::min<uint64_t>(buffer.size(), longitud));
+        if (entrada.leer(buffer.data(), pedir) != pedir) {
+            return "lectura incompleta";
+        }
+        cifrador.procesar(buffer.data(), pedir);
+        if (!salida.escribir(buffer.data(), pedir)) {
+            return "no se pudo escribir la salida";
+        }
+        longitud -= pedir;
+    }
+    return nullptr;
+}
+
+// Lee la cabecera; false si el fichero es demasiado corto o no es OFB1
+bool leerCabecera(Lector &entrada, std::array<uint8_t, 16> &vi) {
+    uint8_t cabecera[ArchivoOFB::kCabecera];
+    if (entrada.leer(cabecera, sizeof(cabecera)) != sizeof(cabecera) ||
+        memcmp(cabecera, kMagia, sizeof(kMagia)) != 0) {
+        return false;
+    }
+    memcpy(vi.data(), cabecera + sizeof(kMagia), vi.size());
+    return true;
+}
+
+} // namespace
+
+#ifdef ARDUINO
+ArchivoOFB::ArchivoOFB(fs::FS &fs, const std::array<uint8_t, 16> &clave, size_t tamBuffer)
+    : fs_(fs), cifrador_(clave, {}),
+#else
+ArchivoOFB::ArchivoOFB(const std::array<uint8_t, 16> &clave, size_t tamBuffer)
+    : cifrador_(clave, {}),
+#endif
+      // Multiplo de bloque para que cada lectura sean bloques enteros
+      tamBuffer_(std::max(cifradorOFB::kBloque, tamBuffer / cifradorOFB::kBloque * cifradorOFB::kBloque)) {
+}
+
+void ArchivoOFB::usarHilos(unsigned hilos) {
+#ifndef ARDUINO
+    if (hilos == 0) {
+        hilos = std::max(1u, std::thread::hardware_concurrency());
+    }
+#endif
+    hilos_ = std::max(1u, hilos);
+}
+
+bool ArchivoOFB::cifrar(const char *entrada, const char *salida, const std::array<uint8_t, 16> &vi) {
+    error_ = "";
+#ifdef ARDUINO
+    Lector lector(fs_, entrada);
+#else
+    Lector lector(entrada);
+#endif
+    if (!lector.abierto()) {
+        return fallo("no se pudo abrir la entrada");
+    }
+    uint8_t cabecera[kCabecera];
+    memcpy(cabecera, kMagia, sizeof(kMagia));
+    memcpy(cabecera + sizeof(kMagia), vi.data(), vi.size());
+    return procesar(entrada, 0, salida, cabecera, lector.tamano(), vi);
+}
+
+bool ArchivoOFB::descifrar(const char *entrada, const char *salida) {
+    error_ = "";
+#ifdef ARDUINO
+    Lector lector(fs_, entrada);
+#else
+    Lector lector(entrada);
+#endif
+    if (!lector.abierto()) {
+        return fallo("no se pudo abrir la entrada");
+    }
+    const uint64_t tamano = lector.tamano();
+    std::array<uint8_t, 16> vi{};
+    if (tamano < kCabecera || !leerCabecera(lector, vi)) {
+        return fallo("cabecera OFB1 no valida");
+    }
+    return procesar(entrada, kCabecera, salida, nullptr, tamano - kCabecera, vi);
+}
+
+bool ArchivoOFB::descifrarRango(const char *archivo, uint64_t desplazamiento,
+                                uint8_t *salida, size_t longitud) {
+    error_ = "";
+#ifdef ARDUINO
+    Lector lector(fs_, archivo);
+#else
+    Lector lector(archivo);
+#endif
+    if (!lector.abierto()) {
+        return fallo("no se pudo abrir la entrada");
+    }
+    const uint64_t tamano = lector.tamano();
+    std::array<uint8_t, 16> vi{};
+    if (tamano < kCabecera || !leerCabecera(lector, vi)) {
+        return fallo("cabecera OFB1 no valida");
+    }
+    if (desplazamiento > tamano - kCabecera || longitud > tamano - kCabecera - desplazamiento) {
+        return fallo("rango fuera del fichero");
+    }
+    if (!lector.irA(kCabecera + desplazamiento) || lector.leer(salida, longitud) != longitud) {
+        return fallo("lectura incompleta");
+    }
+    cifradorOFB cifrador = cifrador_;
+    cifrador.reiniciarVI(vi);
+    cifrador.seekByte(desplazamiento);
+    cifrador.procesar(salida, longitud);
+    return true;
+}
+
+bool ArchivoOFB::procesar(const char *entrada, uint64_t desdeEntrada, const char *salida,
+                          const uint8_t *cabecera, uint64_t longitud,
+                          const std::array<uint8_t, 16> &vi) {
+    // La salida se trunca antes de leer la entrada: sobre si mismo se perderia
+    if (mismoFichero(entrada, salida)) {
+        return fallo("la entrada y la salida son el mismo fichero");
+    }
+    if (!procesarArchivos(entrada, desdeEntrada, salida, cabecera, longitud, vi)) {
+        // No se deja una salida a medias que parezca valida
+#ifdef ARDUINO
+        fs_.remove(salida);
+#else
+        // (solo ficheros normales: la salida puede ser un dispositivo)
+        std::error_code codigo;
+        if (std::filesystem::is_regular_file(salida, codigo)) {
+            std::filesystem::remove(salida, codigo);
+        }
+#endif
+        return false;
+    }
+    return true;
+}
+
+bool ArchivoOFB::mismoFichero(const char *entrada, const char *salida) {
+#ifdef ARDUINO
+    // SPIFFS no tiene enlaces ni rutas relativas
+    return strcmp(entrada, salida) == 0;
+#else
+    std::error_code codigo;
+    return std::filesystem::equivalent(entrada, salida, codigo) && !codigo;
+#endif
+}
+
+bool ArchivoOFB::procesarArchivos(const char *entrada, uint64_t desdeEntrada, const char *salida,
+                                  const uint8_t *cabecera, uint64_t longitud,
+                                  const std::array<uint8_t, 16> &vi) {
+    cifradorOFB cifrador = cifrador_;
+    cifrador.reiniciarVI(vi);
+
+    unsigned hilos = 1;
+#ifndef ARDUINO
+    hilos = static_cast<unsigned>(
+        std::max<uint64_t>(1, std::min<uint64_t>(hilos_, longitud / kMinimoPorHilo)));
+#endif
+
+    if (hilos == 1) {
+#ifdef ARDUINO
+        Lector lector(fs_, entrada);
+        Escritor escritor(fs_, salida);
+#else
+        Lector lector(entrada);
+        Escritor escritor(salida);
+#endif
+        if (!lector.abierto() || !lector.irA(desdeEntrada)) {
+            return fallo("no se pudo abrir la entrada");
+        }
+        if (!escritor.abierto() || (cabecera != nullptr && !escritor.escribir(cabecera, kCabecera))) {
+            return fallo("no se pudo escribir la salida");
+        }
+        const char *problema = procesarTramo(lector, escritor, cifrador, buffer(0), longitud);
+        if (!escritor.cerrar() && problema == nullptr) {
+            problema = "no se pudo cerrar la salida";
+        }
+        return problema == nullptr || fallo(problema);
+    }
+
+#ifndef ARDUINO
+    // Salida con su tamano final; cada hilo escribe su tramo en su sitio
+    const uint64_t desdeSalida = cabecera != nullptr ? kCabecera : 0;
+    {
+        Escritor escritor(salida);
+        if (!escritor.abierto() || (cabecera != nullptr && !escritor.escribir(cabecera, kCabecera))) {
+            return fallo("no se pudo escribir la salida");
+        }
+        if (!escritor.cerrar()) {
+            return fallo("no se pudo cerrar la salida");
+        }
+    }
+    std::error_code codigo;
+    std::filesystem::resize_file(salida, desdeSalida + longitud, codigo);
+    if (codigo) {
+        return fallo("no se pudo escribir la salida");
+    }
+
+    // Tramos alineados a bloque: cada hilo empieza en un bloque entero
+    const uint64_t tramo =
+        (longitud / hilos + cifradorOFB::kBloque - 1) / cifradorOFB::kBloque * cifradorOFB::kBloque;
+    std::vector<const char *> problemas(hilos, nullptr);
+    for (unsigned t = 0; t < hilos; ++t) {
+        buffer(t);
+    }
+    std::vector<std::thread> trabajadores;
+    for (unsigned t = 0; t < hilos && t * tramo < longitud; ++t) {
+        trabajadores.emplace_back([&, t] {
+            const uint64_t inicio = t * tramo;
+            const uint64_t fin = std::min(longitud, inicio + tramo);
+            Lector lector(entrada);
+            Escritor escritor(salida, true);
+            if (!lector.abierto() || !lector.irA(desdeEntrada + inicio)) {
+                problemas[t] = "no se pudo abrir la entrada";
+                return;
+            }
+            if (!escritor.abierto() || !escritor.irA(desdeSalida + inicio)) {
+                problemas[t] = "no se pudo escribir la salida";
+                return;
+            }
+            cifradorOFB propio = cifrador;
+            propio.seekByte(inicio);
+            problemas[t] = procesarTramo(lector, escritor, propio, buffers_[t], fin - inicio);
+            if (!escritor.cerrar() && problemas[t] == nullptr) {
+                problemas[t] = "no se pudo cerrar la salida";
+            }
+        });
+    }
+    for (auto &trabajador : trabajadores) {
+        trabajador.join();
+    }
+    for (const char *problema : problemas) {
+        if (problema != nullptr) {
+            return fallo(problema);
+        }
+    }
+#endif
+    return true;
+}
+
+std::vector<uint8_t> &ArchivoOFB::buffer(size_t indice) {
+    if (buffers_.size() <= indice) {
+        buffers_.resize(indice + 1);
+    }
+    buffers_[indice].resize(tamBuffer_);
+    return buffers_[indice];
+}
+
+bool ArchivoOFB::fallo(const char *mensaje) {
+    error_ = mensaje;
+    return false;
+}
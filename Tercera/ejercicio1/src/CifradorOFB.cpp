@@ -0,0 +1,445 @@
+#include "CifradorOFB.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#if !defined(ARDUINO) && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define OFB_SSSE3 1
+#include <immintrin.h>
+#elif !defined(ARDUINO) && defined(__aarch64__) && defined(__BYTE_ORDER__) && \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define OFB_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+struct PermEntry {
+    uint8_t destino;
+    std::array<int8_t, 4> vi;
+    uint8_t totalVI;
+    uint8_t keyIndex;
+};
+
+constexpr std::array<PermEntry, 16> kPermutacion = {{
+    {15, {3, 6, -1, -1}, 2, 4},
+    {14, {13, 10, -1, -1}, 2, 2},
+    {13, {9, 1, -1, -1}, 2, 13},
+    {12, {10, 14, -1, -1}, 2, 7},
+    {11, {12, 5, -1, -1}, 2, 15},
+    {10, {0, 2, -1, -1}, 2, 1},
+    {9, {3, 6, -1, -1}, 2, 14},
+    {8, {0, 13, -1, -1}, 2, 6},
+    {7, {8, 5, -1, -1}, 2, 12},
+    {6, {3, 10, -1, -1}, 2, 0},
+    {5, {2, 9, -1, -1}, 2, 3},
+    {4, {3, 11, -1, -1}, 2, 11},
+    {3, {1, 14, -1, -1}, 2, 5},
+    {2, {7, 15, -1, -1}, 2, 10},
+    {1, {2, 5, -1, -1}, 2, 8},
+    {0, {0, 4, 10, -1}, 3, 9},
+}};
+
+// Cada byte destino debe aparecer exactamente una vez en la tabla
+constexpr bool permutacionValida() {
+    uint32_t vistos = 0;
+    for (const auto &entrada : kPermutacion) {
+        if (entrada.destino >= 16 || (vistos & (1u << entrada.destino)) != 0 ||
+            entrada.keyIndex >= 16 || entrada.totalVI > 4) {
+            return false;
+        }
+        for (uint8_t i = 0; i < entrada.totalVI; ++i) {
+            if (entrada.vi[i] < 0 || entrada.vi[i] >= 16) {
+                return false;
+            }
+        }
+        vistos |= 1u << entrada.destino;
+    }
+    return vistos == 0xFFFF;
+}
+static_assert(permutacionValida(), "kPermutacion no es una permutacion de 16 bytes");
+
+// El estado se guarda como dos palabras de 64 bits: palabra 0 = bytes 0..7,
+// palabra 1 = bytes 8..15, byte i en los bits 8 * (i % 8).
+template <int indice>
+inline uint8_t byteEstado(const uint64_t (&estado)[2]) {
+    if constexpr (indice < 0) {
+        return 0;
+    } else {
+        return static_cast<uint8_t>(estado[indice / 8] >> (8 * (indice % 8)));
+    }
+}
+
+// Indice k del VI de una entrada, o -1 si la entrada usa menos
+constexpr int indiceVI(const PermEntry &e, uint8_t k) {
+    return k < e.totalVI ? e.vi[k] : -1;
+}
+
+// XOR de los bytes del VI de la entrada E, colocado ya en su byte destino.
+// Todos los indices y desplazamientos son constantes de compilacion.
+template <size_t E>
+inline uint64_t entradaPermutacion(const uint64_t (&estado)[2]) {
+    constexpr PermEntry e = kPermutacion[E];
+    const uint8_t acumulado = static_cast<uint8_t>(
+        byteEstado<indiceVI(e, 0)>(estado) ^ byteEstado<indiceVI(e, 1)>(estado) ^
+        byteEstado<indiceVI(e, 2)>(estado) ^ byteEstado<indiceVI(e, 3)>(estado));
+    return static_cast<uint64_t>(acumulado) << (8 * (e.destino % 8));
+}
+
+template <size_t... E>
+inline void permutar(const uint64_t (&estado)[2], uint64_t (&nuevo)[2],
+                     std::index_sequence<E...>) {
+    ((nuevo[kPermutacion[E].destino / 8] ^= entradaPermutacion<E>(estado)), ...);
+}
+
+void aPalabras(const std::array<uint8_t, 16> &bytes, uint64_t (&palabras)[2]) {
+    palabras[0] = 0;
+    palabras[1] = 0;
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        palabras[i / 8] |= static_cast<uint64_t>(bytes[i]) << (8 * (i % 8));
+    }
+}
+
+// Un bloque: nuevo = permutacion(estado) ^ constante
+inline void bloqueEscalar(uint64_t (&estado)[2], const uint64_t (&constante)[2]) {
+    uint64_t nuevo[2] = {constante[0], constante[1]};
+    permutar(estado, nuevo, std::make_index_sequence<kPermutacion.size()>{});
+    estado[0] = nuevo[0];
+    estado[1] = nuevo[1];
+}
+
+void guardarBloque(const uint64_t (&estado)[2], uint8_t *salida) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    std::memcpy(salida, estado, cifradorOFB::kBloque);
+#else
+    for (size_t i = 0; i < cifradorOFB::kBloque; ++i) {
+        salida[i] = static_cast<uint8_t>(estado[i / 8] >> (8 * (i % 8)));
+    }
+#endif
+}
+
+// Genera `bloques` bloques; con salida == nullptr solo avanza el estado
+void bloquesEscalar(uint64_t (&estado)[2], const uint64_t (&constante)[2],
+                    uint8_t *salida, size_t bloques) {
+    for (size_t b = 0; b < bloques; ++b) {
+        bloqueEscalar(estado, constante);
+        if (salida != nullptr) {
+            guardarBloque(estado, salida + b * cifradorOFB::kBloque);
+        }
+    }
+}
+
+// Parte lineal de la actualizacion como matriz de bits: la fila i (dos
+// palabras, mismo orden de bits que el estado) marca los bits del estado
+// cuyo XOR da el bit i del bloque nuevo. Se construye en compilacion.
+struct MatrizGF2 {
+    uint64_t fila[128][2];
+};
+
+constexpr MatrizGF2 generarMatriz() {
+    MatrizGF2 matriz{};
+    for (const auto &entrada : kPermutacion) {
+        for (uint8_t k = 0; k < entrada.totalVI; ++k) {
+            for (int bit = 0; bit < 8; ++bit) {
+                const int destino = 8 * entrada.destino + bit;
+                const int origen = 8 * entrada.vi[k] + bit;
+                matriz.fila[destino][origen / 64] ^= 1ULL << (origen % 64);
+            }
+        }
+    }
+    return matriz;
+}
+
+constexpr MatrizGF2 kMatriz = generarMatriz();
+
+// Transformacion afin x -> m x ^ v
+struct Afin {
+    MatrizGF2 m;
+    uint64_t v[2];
+};
+
+inline uint64_t paridad(uint64_t x) {
+    return static_cast<uint64_t>(__builtin_popcountll(x) & 1);
+}
+
+void aplicarMatriz(const MatrizGF2 &m, const uint64_t (&x)[2], uint64_t (&y)[2]) {
+    uint64_t r[2] = {0, 0};
+    for (int i = 0; i < 128; ++i) {
+        r[i / 64] |= paridad((m.fila[i][0] & x[0]) ^ (m.fila[i][1] & x[1])) << (i % 64);
+    }
+    y[0] = r[0];
+    y[1] = r[1];
+}
+
+// out = a * b: la fila i de out es el XOR de las filas j de b marcadas en
+// la fila i de a (se recorren solo los bits a 1)
+void multiplicar(const MatrizGF2 &a, const MatrizGF2 &b, MatrizGF2 &out) {
+    for (int i = 0; i < 128; ++i) {
+        uint64_t r0 = 0;
+        uint64_t r1 = 0;
+        for (int w = 0; w < 2; ++w) {
+            for (uint64_t bits = a.fila[i][w]; bits != 0; bits &= bits - 1) {
+                const int j = 64 * w + __builtin_ctzll(bits);
+                r0 ^= b.fila[j][0];
+                r1 ^= b.fila[j][1];
+            }
+        }
+        out.fila[i][0] = r0;
+        out.fila[i][1] = r1;
+    }
+}
+
+// f = f o f
+void cuadrado(Afin &f, MatrizGF2 &temporal) {
+    uint64_t mv[2];
+    aplicarMatriz(f.m, f.v, mv);
+    f.v[0] ^= mv[0];
+    f.v[1] ^= mv[1];
+    multiplicar(f.m, f.m, temporal);
+    f.m = temporal;
+}
+
+// Por debajo de esto es mas barato generar los bloques que elevar la matriz
+constexpr uint64_t kSaltoMinimo = 512;
+
+#if defined(OFB_SSSE3) || defined(OFB_NEON)
+// Mascaras de seleccion para pshufb/tbl: la mascara k lleva en cada byte
+// destino el indice del k-esimo byte del VI, o 0x80 (byte a cero) si la
+// entrada usa menos de k + 1 bytes.
+struct Mascaras {
+    uint8_t m[4][16];
+};
+
+constexpr Mascaras generarMascaras() {
+    Mascaras mascaras{};
+    for (const auto &entrada : kPermutacion) {
+        for (uint8_t k = 0; k < 4; ++k) {
+            mascaras.m[k][entrada.destino] =
+                k < entrada.totalVI ? static_cast<uint8_t>(entrada.vi[k]) : 0x80;
+        }
+    }
+    return mascaras;
+}
+
+constexpr Mascaras kMascaras = generarMascaras();
+
+constexpr size_t maximoVI() {
+    size_t maximo = 0;
+    for (const auto &entrada : kPermutacion) {
+        maximo = entrada.totalVI > maximo ? entrada.totalVI : maximo;
+    }
+    return maximo;
+}
+
+// Solo se aplican las mascaras que algun byte usa (3 con la tabla actual)
+constexpr size_t kMascarasUsadas = maximoVI();
+#endif
+
+#ifdef OFB_SSSE3
+// El estado de 16 bytes cabe en un registro; el orden de bytes coincide
+// con el de las dos palabras de 64 bits (x86 es little-endian).
+__attribute__((target("ssse3")))
+void bloquesSSSE3(uint64_t (&estado)[2], const uint64_t (&constante)[2],
+                  uint8_t *salida, size_t bloques) {
+    __m128i m[4];
+    for (size_t k = 0; k < 4; ++k) {
+        m[k] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(kMascaras.m[k]));
+    }
+    const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(constante));
+    __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(estado));
+    for (size_t b = 0; b < bloques; ++b) {
+        __m128i nuevo = _mm_xor_si128(c, _mm_shuffle_epi8(s, m[0]));
+        for (size_t k = 1; k < kMascarasUsadas; ++k) {
+            nuevo = _mm_xor_si128(nuevo, _mm_shuffle_epi8(s, m[k]));
+        }
+        s = nuevo;
+        if (salida != nullptr) {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(salida + b * cifradorOFB::kBloque), s);
+        }
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(estado), s);
+}
+#endif
+
+#ifdef OFB_NEON
+void bloquesNEON(uint64_t (&estado)[2], const uint64_t (&constante)[2],
+                 uint8_t *salida, size_t bloques) {
+    // tbl devuelve 0 para indices fuera de rango, igual que 0x80 en pshufb
+    uint8x16_t m[4];
+    for (size_t k = 0; k < 4; ++k) {
+        m[k] = vld1q_u8(kMascaras.m[k]);
+    }
+    const uint8x16_t c = vld1q_u8(reinterpret_cast<const uint8_t *>(constante));
+    uint8x16_t s = vld1q_u8(reinterpret_cast<const uint8_t *>(estado));
+    for (size_t b = 0; b < bloques; ++b) {
+        uint8x16_t nuevo = veorq_u8(c, vqtbl1q_u8(s, m[0]));
+        for (size_t k = 1; k < kMascarasUsadas; ++k) {
+            nuevo = veorq_u8(nuevo, vqtbl1q_u8(s, m[k]));
+        }
+        s = nuevo;
+        if (salida != nullptr) {
+            vst1q_u8(salida + b * cifradorOFB::kBloque, s);
+        }
+    }
+    vst1q_u8(reinterpret_cast<uint8_t *>(estado), s);
+}
+#endif
+
+using GeneradorBloques = void (*)(uint64_t (&)[2], const uint64_t (&)[2], uint8_t *, size_t);
+
+struct Implementacion {
+    GeneradorBloques generar;
+    const char *nombre;
+};
+
+Implementacion elegirImplementacion() {
+#if defined(OFB_SSSE3)
+    if (__builtin_cpu_supports("ssse3")) {
+        return {bloquesSSSE3, "ssse3"};
+    }
+#elif defined(OFB_NEON)
+    return {bloquesNEON, "neon"};
+#endif
+    return {bloquesEscalar, "escalar"};
+}
+
+Implementacion &implementacionActual() {
+    static Implementacion actual = elegirImplementacion();
+    return actual;
+}
+
+} // namespace
+
+cifradorOFB::cifradorOFB(const std::array<uint8_t, 16> &clave,
+                         const std::array<uint8_t, 16> &vi) {
+    // ~(x ^ k) == x ^ ~k: la clave y la negacion se reducen a una
+    // constante por byte destino, calculada una sola vez
+    std::array<uint8_t, 16> constante{};
+    for (const auto &entrada : kPermutacion) {
+        constante[entrada.destino] =
+            static_cast<uint8_t>(~clave[entrada.keyIndex]);
+    }
+    aPalabras(constante, constante_);
+    reiniciarVI(vi);
+}
+
+void cifradorOFB::reiniciarVI(const std::array<uint8_t, 16> &vi) {
+    aPalabras(vi, vi_);
+    estado_[0] = vi_[0];
+    estado_[1] = vi_[1];
+    cursor_ = kBloque;
+}
+
+void cifradorOFB::seek(uint64_t bloque) {
+    // El bloque n es A^(n+1)(VI): basta dejar el estado en A^n(VI)
+    estado_[0] = vi_[0];
+    estado_[1] = vi_[1];
+    cursor_ = kBloque;
+    if (bloque < kSaltoMinimo) {
+        generarBloques(nullptr, bloque);
+        return;
+    }
+
+    // Las potencias de A conmutan: se aplica A^(2^k) por cada bit de n.
+    // Las matrices (8 KiB) van al heap para no cargar la pila de la placa.
+    std::unique_ptr<Afin> potencia(new Afin{kMatriz, {constante_[0], constante_[1]}});
+    std::unique_ptr<MatrizGF2> temporal(new MatrizGF2);
+    for (uint64_t n = bloque; n != 0; n >>= 1) {
+        if (n & 1) {
+            aplicarMatriz(potencia->m, estado_, estado_);
+            estado_[0] ^= potencia->v[0];
+            estado_[1] ^= potencia->v[1];
+        }
+        if (n > 1) {
+            cuadrado(*potencia, *temporal);
+        }
+    }
+}
+
+void cifradorOFB::seekByte(uint64_t desplazamiento) {
+    seek(desplazamiento / kBloque);
+    if (desplazamiento % kBloque != 0) {
+        generarSiguienteBloque();
+        cursor_ = static_cast<size_t>(desplazamiento % kBloque);
+    }
+}
+
+void cifradorOFB::procesar(const uint8_t *entrada, uint8_t *salida, size_t longitud) {
+    // Resto del bloque actual
+    while (longitud > 0 && cursor_ < kBloque) {
+        *salida++ = procesarByte(*entrada++);
+        --longitud;
+    }
+
+    // Bloques enteros: keystream por lotes en la pila y XOR de 64 bits
+    uint8_t keystream[kBloquesPorLote * kBloque];
+    while (longitud >= kBloque) {
+        const size_t bloques = std::min(longitud / kBloque, kBloquesPorLote);
+        generarBloques(keystream, bloques);
+        for (size_t i = 0; i < bloques * kBloque; i += 8) {
+            uint64_t dato;
+            uint64_t clave;
+            std::memcpy(&dato, entrada + i, sizeof(dato));
+            std::memcpy(&clave, keystream + i, sizeof(clave));
+            dato ^= clave;
+            std::memcpy(salida + i, &dato, sizeof(dato));
+        }
+        entrada += bloques * kBloque;
+        salida += bloques * kBloque;
+        longitud -= bloques * kBloque;
+    }
+
+    // Bloque final incompleto
+    while (longitud > 0) {
+        *salida++ = procesarByte(*entrada++);
+        --longitud;
+    }
+}
+
+std::vector<uint8_t> cifradorOFB::procesar(const std::vector<uint8_t> &datos) {
+    std::vector<uint8_t> resultado(datos.size());
+    procesar(datos.data(), resultado.data(), datos.size());
+    return resultado;
+}
+
+void cifradorOFB::generarBloques(uint8_t *salida, size_t bloques) {
+    implementacionActual().generar(estado_, constante_, salida, bloques);
+    cursor_ = kBloque;
+}
+
+void cifradorOFB::filaLineal(size_t bit, uint64_t (&fila)[2]) {
+    fila[0] = kMatriz.fila[bit][0];
+    fila[1] = kMatriz.fila[bit][1];
+}
+
+size_t cifradorOFB::indiceClave(size_t byteDestino) {
+    for (const auto &entrada : kPermutacion) {
+        if (entrada.destino == byteDestino) {
+            return entrada.keyIndex;
+        }
+    }
+    return 0;
+}
+
+const char *cifradorOFB::implementacion() {
+    return implementacionActual().nombre;
+}
+
+void cifradorOFB::usarEscalar(bool escalar) {
+    implementacionActual() =
+        escalar ? Implementacion{bloquesEscalar, "escalar"} : elegirImplementacion();
+}
+
+// Con SIMD, un bloque son 2-3 shuffles y XOR sobre un registro; sin SIMD,
+// kPermutacion desplegada en compilacion (16 expresiones XOR fijas)
+void cifradorOFB::generarSiguienteBloque() {
+#if defined(OFB_SSSE3) || defined(OFB_NEON)
+    implementacionActual().generar(estado_, constante_, nullptr, 1);
+#else
+    bloqueEscalar(estado_, constante_);
+#endif
+    cursor_ = 0;
+}
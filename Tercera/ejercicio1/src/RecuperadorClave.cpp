@@ -0,0 +1,268 @@
+#include "RecuperadorClave.h"
+
+#include "CifradorOFB.h"
+
+#include <algorithm>
+#include <map>
+
+#ifndef ARDUINO
+#include <atomic>
+#include <thread>
+#endif
+
+namespace {
+
+// Incognitas: bits de clave en las columnas 0..127 y de VI en 128..255
+// (bit 8*byte + bit). La palabra 4 guarda el termino independiente.
+constexpr size_t kIncognitas = 256;
+constexpr size_t kColumnaVI = 128;
+constexpr size_t kPalabras = kIncognitas / 64 + 1;
+constexpr size_t kBloqueM4RI = 8;
+
+using Fila = std::array<uint64_t, kPalabras>;
+
+bool bit(const Fila &fila, size_t columna) {
+    return ((fila[columna / 64] >> (columna % 64)) & 1) != 0;
+}
+
+void ponerBit(Fila &fila, size_t columna) {
+    fila[columna / 64] ^= 1ULL << (columna % 64);
+}
+
+void xorFila(Fila &destino, const Fila &origen) {
+    for (size_t w = 0; w < kPalabras; ++w) {
+        destino[w] ^= origen[w];
+    }
+}
+
+// Estructura lineal de una actualizacion, leida una vez del cifrador
+struct Estructura {
+    std::array<std::vector<uint8_t>, 128> origenes;  // bits del estado por bit nuevo
+    std::array<uint8_t, 128> bitClave;               // bit de clave por bit nuevo
+
+    Estructura() {
+        for (size_t i = 0; i < 128; ++i) {
+            uint64_t fila[2];
+            cifradorOFB::filaLineal(i, fila);
+            for (size_t j = 0; j < 128; ++j) {
+                if ((fila[j / 64] >> (j % 64)) & 1) {
+                    origenes[i].push_back(static_cast<uint8_t>(j));
+                }
+            }
+            bitClave[i] = static_cast<uint8_t>(8 * cifradorOFB::indiceClave(i / 8) + i % 8);
+        }
+    }
+};
+
+const Estructura &estructura() {
+    static const Estructura instancia;
+    return instancia;
+}
+
+// Cada bit del estado s_n como expresion afin de las incognitas; se avanza
+// un bloque cada vez
+class Expresiones {
+public:
+    Expresiones() {
+        for (size_t i = 0; i < 128; ++i) {
+            estado_[i] = Fila{};
+            ponerBit(estado_[i], kColumnaVI + i);
+        }
+    }
+
+    void avanzar() {
+        const Estructura &e = estructura();
+        std::array<Fila, 128> nuevo;
+        for (size_t i = 0; i < 128; ++i) {
+            Fila fila{};
+            for (uint8_t j : e.origenes[i]) {
+                xorFila(fila, estado_[j]);
+            }
+            // ~clave: el bit de clave mas la constante 1
+            ponerBit(fila, e.bitClave[i]);
+            fila[kPalabras - 1] ^= 1;
+            nuevo[i] = fila;
+        }
+        estado_ = nuevo;
+        ++bloque_;
+    }
+
+    uint64_t bloque() const { return bloque_; }
+    const Fila &bitEstado(size_t i) const { return estado_[i]; }
+
+private:
+    std::array<Fila, 128> estado_;
+    uint64_t bloque_ = 0;
+};
+
+// Forma escalonada reducida. Por cada bloque de 8 columnas se buscan sus
+// pivotes (reduciendo las filas candidatas contra los ya encontrados), se
+// tabulan las 256 combinaciones de esas filas indexadas por los 8 bits del
+// bloque y cada una de las demas filas se limpia con un solo XOR.
+// Devuelve el rango; las filas [0, rango) son las de pivote.
+size_t escalonar(std::vector<Fila> &filas, std::vector<size_t> &pivotes) {
+    size_t rango = 0;
+    std::vector<Fila> tabla(1 << kBloqueM4RI);
+    for (size_t inicio = 0; inicio < kIncognitas && rango < filas.size(); inicio += kBloqueM4RI) {
+        const size_t primera = rango;
+        for (size_t c = inicio; c < inicio + kBloqueM4RI && rango < filas.size(); ++c) {
+            size_t encontrada = filas.size();
+            for (size_t p = rango; p < filas.size(); ++p) {
+                for (size_t q = primera; q < rango; ++q) {
+                    if (bit(filas[p], pivotes[q])) {
+                        xorFila(filas[p], filas[q]);
+                    }
+                }
+                if (bit(filas[p], c)) {
+                    encontrada = p;
+                    break;
+                }
+            }
+            if (encontrada == filas.size()) {
+                continue;
+            }
+            std::swap(filas[rango], filas[encontrada]);
+            for (size_t q = primera; q < rango; ++q) {
+                if (bit(filas[q], c)) {
+                    xorFila(filas[q], filas[rango]);
+                }
+            }
+            pivotes.push_back(c);
+            ++rango;
+        }
+        if (rango == primera) {
+            continue;
+        }
+
+        // tabla[v]: combinacion de pivotes que anula los bits v del bloque
+        // (los bits de columnas sin pivote no aportan nada)
+        tabla[0] = Fila{};
+        for (size_t v = 1; v < tabla.size(); ++v) {
+            const size_t columna = inicio + static_cast<size_t>(__builtin_ctzll(v));
+            tabla[v] = tabla[v & (v - 1)];
+            for (size_t q = primera; q < rango; ++q) {
+                if (pivotes[q] == columna) {
+                    xorFila(tabla[v], filas[q]);
+                }
+            }
+        }
+        const size_t palabra = inicio / 64;
+        const size_t desplazamiento = inicio % 64;
+        for (size_t p = 0; p < filas.size(); ++p) {
+            if (p >= primera && p < rango) {
+                continue;
+            }
+            const size_t v = (filas[p][palabra] >> desplazamiento) & (tabla.size() - 1);
+            if (v != 0) {
+                xorFila(filas[p], tabla[v]);
+            }
+        }
+    }
+    return rango;
+}
+
+} // namespace
+
+ResultadoClave recuperarClave(const MensajeCapturado &mensaje) {
+    ResultadoClave resultado;
+    std::vector<Fila> filas;
+
+    if (mensaje.conVI) {
+        for (size_t i = 0; i < 128; ++i) {
+            Fila fila{};
+            ponerBit(fila, kColumnaVI + i);
+            fila[kPalabras - 1] = (mensaje.vi[i / 8] >> (i % 8)) & 1;
+            filas.push_back(fila);
+        }
+    }
+
+    // Bytes de keystream conocidos por bloque (el bloque b es el estado s_{b+1})
+    std::map<uint64_t, std::vector<std::pair<size_t, uint8_t>>> porBloque;
+    for (const auto &fragmento : mensaje.conocidos) {
+        for (size_t i = 0; i < fragmento.claro.size(); ++i) {
+            const uint64_t posicion = fragmento.desplazamiento + i;
+            if (posicion >= mensaje.cifrado.size()) {
+                break;
+            }
+            const uint8_t keystream = static_cast<uint8_t>(fragmento.claro[i] ^ mensaje.cifrado[posicion]);
+            porBloque[posicion / cifradorOFB::kBloque].emplace_back(
+                static_cast<size_t>(posicion % cifradorOFB::kBloque), keystream);
+        }
+    }
+
+    Expresiones expresiones;
+    for (const auto &bloque : porBloque) {
+        while (expresiones.bloque() <= bloque.first) {
+            expresiones.avanzar();
+        }
+        for (const auto &conocido : bloque.second) {
+            for (size_t b = 0; b < 8; ++b) {
+                Fila fila = expresiones.bitEstado(8 * conocido.first + b);
+                fila[kPalabras - 1] ^= (conocido.second >> b) & 1;
+                filas.push_back(fila);
+            }
+        }
+    }
+
+    resultado.ecuaciones = static_cast<unsigned>(filas.size());
+    std::vector<size_t> pivotes;
+    const size_t rango = escalonar(filas, pivotes);
+    resultado.rango = static_cast<unsigned>(rango);
+    for (size_t p = rango; p < filas.size(); ++p) {
+        if (filas[p][kPalabras - 1] & 1) {
+            resultado.consistente = false;
+            return resultado;
+        }
+    }
+
+    // Un bit de clave esta determinado si su fila de pivote no depende de
+    // ninguna variable libre
+    size_t determinados = 0;
+    for (size_t q = 0; q < rango; ++q) {
+        if (pivotes[q] >= kColumnaVI) {
+            continue;
+        }
+        size_t unos = 0;
+        for (size_t w = 0; w + 1 < kPalabras; ++w) {
+            unos += static_cast<size_t>(__builtin_popcountll(filas[q][w]));
+        }
+        if (unos == 1) {
+            if (filas[q][kPalabras - 1] & 1) {
+                resultado.clave[pivotes[q] / 8] |= static_cast<uint8_t>(1u << (pivotes[q] % 8));
+            }
+            ++determinados;
+        }
+    }
+    resultado.resuelta = determinados == kColumnaVI;
+    return resultado;
+}
+
+std::vector<ResultadoClave> recuperarClaves(const std::vector<MensajeCapturado> &mensajes,
+                                            unsigned hilos) {
+    std::vector<ResultadoClave> resultados(mensajes.size());
+    estructura();  // se construye antes de repartir
+#ifdef ARDUINO
+    (void)hilos;
+    for (size_t i = 0; i < mensajes.size(); ++i) {
+        resultados[i] = recuperarClave(mensajes[i]);
+    }
+#else
+    if (hilos == 0) {
+        hilos = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // Reparto dinamico: los mensajes pueden tener coste muy distinto
+    std::atomic<size_t> siguiente{0};
+    std::vector<std::thread> trabajadores;
+    for (unsigned t = 0; t < hilos; ++t) {
+        trabajadores.emplace_back([&] {
+            for (size_t i = siguiente++; i < mensajes.size(); i = siguiente++) {
+                resultados[i] = recuperarClave(mensajes[i]);
+            }
+        });
+    }
+    for (auto &trabajador : trabajadores) {
+        trabajador.join();
+    }
+#endif
+    return resultados;
+}
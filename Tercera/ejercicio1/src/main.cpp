@@ -1,128 +1,63 @@
 
 // Implementación de un cifrador OFB personalizado para bloques de 8 bits
 #include <Arduino.h>
+#include <SPIFFS.h>
 #include <array>
 #include <cstring>
-#include <string>
-#include <vector>
 
-namespace {
+#include "ArchivoOFB.h"
+#include "CifradorOFB.h"
+#include "hexcodec.h"
 
-struct PermEntry {
-    uint8_t destino;
-    std::array<int8_t, 4> vi;
-    uint8_t totalVI;
-    uint8_t keyIndex;
-};
-
-constexpr std::array<PermEntry, 16> kPermutacion = {{
-    {15, {3, 6, -1, -1}, 2, 4},
-    {14, {13, 10, -1, -1}, 2, 2},
-    {13, {9, 1, -1, -1}, 2, 13},
-    {12, {10, 14, -1, -1}, 2, 7},
-    {11, {12, 5, -1, -1}, 2, 15},
-    {10, {0, 2, -1, -1}, 2, 1},
-    {9, {3, 6, -1, -1}, 2, 14},
-    {8, {0, 13, -1, -1}, 2, 6},
-    {7, {8, 5, -1, -1}, 2, 12},
-    {6, {3, 10, -1, -1}, 2, 0},
-    {5, {2, 9, -1, -1}, 2, 3},
-    {4, {3, 11, -1, -1}, 2, 11},
-    {3, {1, 14, -1, -1}, 2, 5},
-    {2, {7, 15, -1, -1}, 2, 10},
-    {1, {2, 5, -1, -1}, 2, 8},
-    {0, {0, 4, 10, -1}, 3, 9},
-}};
-
-uint8_t hexToNibble(char c) {
-    if (c >= '0' && c <= '9') {
-        return static_cast<uint8_t>(c - '0');
-    }
-    if (c >= 'a' && c <= 'f') {
-        return static_cast<uint8_t>(10 + c - 'a');
-    }
-    if (c >= 'A' && c <= 'F') {
-        return static_cast<uint8_t>(10 + c - 'A');
-    }
-    return 0;
-}
+namespace {
 
-std::array<uint8_t, 16> hexStringToArray(const char *hex) {
-    std::array<uint8_t, 16> resultado{};
-    size_t longitud = strlen(hex);
-    if (longitud < 32) {
-        return resultado;
+// Convierte exactamente 32 caracteres hex; informa del primer caracter
+// invalido en lugar de tomarlo como 0.
+bool hexStringToArray(const char *etiqueta, const char *hex,
+                      std::array<uint8_t, 16> &resultado) {
+    size_t posicion = 0;
+    if (hexcodec::decode(hex, resultado, &posicion)) {
+        return true;
     }
-    for (size_t i = 0; i < resultado.size(); ++i) {
-        resultado[i] = static_cast<uint8_t>((hexToNibble(hex[2 * i]) << 4) |
-                                            hexToNibble(hex[2 * i + 1]));
-    }
-    return resultado;
+    Serial.printf("%s no valida: se esperan 32 digitos hex (error en la posicion %u)\n",
+                  etiqueta, static_cast<unsigned>(posicion));
+    return false;
 }
 
-void imprimirBuffer(const char *etiqueta, const std::vector<uint8_t> &datos) {
+void imprimirBuffer(const char *etiqueta, const uint8_t *datos, size_t longitud) {
     Serial.printf("%s", etiqueta);
-    for (uint8_t valor : datos) {
-        Serial.printf("%02X ", valor);
+    for (size_t i = 0; i < longitud; ++i) {
+        Serial.printf("%02X ", datos[i]);
     }
     Serial.println();
 }
 
-} // namespace
-
-class cifradorOFB {
-public:
-    cifradorOFB(const std::array<uint8_t, 16> &clave,
-                const std::array<uint8_t, 16> &vi)
-        : clave_(clave), estadoVI_(vi) {
-        cursor_ = keystream_.size();
-    }
-
-    void reiniciarVI(const std::array<uint8_t, 16> &vi) {
-        estadoVI_ = vi;
-        cursor_ = keystream_.size();
+// Cifra y descifra un fichero de /data subido a SPIFFS
+void demoArchivo(const std::array<uint8_t, 16> &clave, const std::array<uint8_t, 16> &vi) {
+    const char *original = "/Preguntas_Moodle_20210123.txt";
+    const char *cifrado = "/Preguntas_Moodle_20210123.ofb";
+    const char *descifrado = "/Preguntas_Moodle_20210123.dec";
+    if (!SPIFFS.begin(true) || !SPIFFS.exists(original)) {
+        Serial.printf("Fichero %s no disponible en SPIFFS\n", original);
+        return;
     }
 
-    uint8_t procesarByte(uint8_t dato) {
-        if (cursor_ >= keystream_.size()) {
-            generarSiguienteBloque();
-        }
-        uint8_t salida = dato ^ keystream_[cursor_];
-        ++cursor_;
-        return salida;
+    ArchivoOFB archivo(SPIFFS, clave);
+    const unsigned long inicio = millis();
+    if (!archivo.cifrar(original, cifrado, vi) || !archivo.descifrar(cifrado, descifrado)) {
+        Serial.printf("Error con el fichero: %s\n", archivo.error());
+        return;
     }
+    Serial.printf("Fichero %s cifrado y descifrado en %lu ms\n", original, millis() - inicio);
 
-    std::vector<uint8_t> procesar(const std::vector<uint8_t> &datos) {
-        std::vector<uint8_t> resultado;
-        resultado.reserve(datos.size());
-        for (uint8_t byte : datos) {
-            resultado.push_back(procesarByte(byte));
-        }
-        return resultado;
+    uint8_t inicioTexto[32];
+    if (archivo.descifrarRango(cifrado, 0, inicioTexto, sizeof(inicioTexto))) {
+        Serial.printf("Primeros bytes: %.*s\n", static_cast<int>(sizeof(inicioTexto)),
+                      reinterpret_cast<const char *>(inicioTexto));
     }
+}
 
-private:
-    std::array<uint8_t, 16> clave_{};
-    std::array<uint8_t, 16> estadoVI_{};
-    std::array<uint8_t, 16> keystream_{};
-    size_t cursor_ = 0;
-
-    void generarSiguienteBloque() {
-        std::array<uint8_t, 16> nuevo{};
-        for (const auto &entrada : kPermutacion) {
-            uint8_t acumulado = 0;
-            for (uint8_t i = 0; i < entrada.totalVI; ++i) {
-                int8_t indice = entrada.vi[i];
-                acumulado ^= estadoVI_[indice];
-            }
-            acumulado ^= clave_[entrada.keyIndex];
-            nuevo[entrada.destino] = static_cast<uint8_t>(~acumulado);
-        }
-        estadoVI_ = nuevo;
-        keystream_ = nuevo;
-        cursor_ = 0;
-    }
-};
+} // namespace
 
 void setup() {
     Serial.begin(115200);
@@ -133,25 +68,43 @@ void setup() {
     pinMode(43, OUTPUT);
     digitalWrite(43, HIGH);
 
-    const auto clave =
-        hexStringToArray("00112233445566778899AABBCCDDEEFF");
-    const auto vi = hexStringToArray("0F1E2D3C4B5A69788796A5B4C3D2E1F0");
+    std::array<uint8_t, 16> clave{};
+    std::array<uint8_t, 16> vi{};
+    if (!hexStringToArray("Clave", "00112233445566778899AABBCCDDEEFF", clave) ||
+        !hexStringToArray("VI", "0F1E2D3C4B5A69788796A5B4C3D2E1F0", vi)) {
+        return;
+    }
 
     cifradorOFB ofb(clave, vi);
 
+    // Todo en buffers fijos: cifrado y descifrado en el sitio, sin reservar memoria
     const char *mensaje = "Criptografia OFB";
-    std::vector<uint8_t> plano(mensaje, mensaje + strlen(mensaje));
+    const size_t longitud = strlen(mensaje);
+    uint8_t cifrado[64];
+    uint8_t descifrado[64];
+    if (longitud > sizeof(cifrado)) {
+        return;
+    }
 
-    auto cifrado = ofb.procesar(plano);
+    ofb.procesar(reinterpret_cast<const uint8_t *>(mensaje), cifrado, longitud);
 
     ofb.reiniciarVI(vi);
-    auto descifrado = ofb.procesar(cifrado);
-    std::string textoDescifrado(descifrado.begin(), descifrado.end());
+    ofb.procesar(cifrado, descifrado, longitud);
 
     Serial.println("=== OFB_Cripto ===");
     Serial.printf("Mensaje original: %s\n", mensaje);
-    imprimirBuffer("Cifrado (hex): ", cifrado);
-    Serial.printf("Descifrado: %s\n", textoDescifrado.c_str());
+    imprimirBuffer("Cifrado (hex): ", cifrado, longitud);
+    Serial.printf("Descifrado: %.*s\n", static_cast<int>(longitud),
+                  reinterpret_cast<const char *>(descifrado));
+
+    // Acceso directo a un rango: el keystream se posiciona sin recorrer lo anterior
+    const size_t inicio = 5;
+    ofb.seekByte(inicio);
+    ofb.procesar(cifrado + inicio, descifrado, longitud - inicio);
+    Serial.printf("Descifrado desde el byte %u: %.*s\n", static_cast<unsigned>(inicio),
+                  static_cast<int>(longitud - inicio), reinterpret_cast<const char *>(descifrado));
+
+    demoArchivo(clave, vi);
 }
 
 void loop() {
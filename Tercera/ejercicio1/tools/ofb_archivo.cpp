@@ -0,0 +1,103 @@
+/* Host tool: cifra y descifra ficheros con el cifrador OFB personalizado
+ * (formato "OFB1" + VI + datos, ver ArchivoOFB.h).
+ *
+ * Build (from Tercera/ejercicio1):
+ *   g++ -std=c++17 -O2 -pthread -Iinclude -I../lib/hexcodec tools/ofb_archivo.cpp \
+ *       src/ArchivoOFB.cpp src/CifradorOFB.cpp ../lib/hexcodec/hexcodec.cpp -o ofb_archivo
+ *
+ * Usage:
+ *   ofb_archivo cifrar    <clave-hex> <entrada> <salida> [hilos] [vi-hex]
+ *   ofb_archivo descifrar <clave-hex> <entrada> <salida> [hilos]
+ *   ofb_archivo rango     <clave-hex> <cifrado> <desplazamiento> <longitud>
+ * Sin VI se genera uno aleatorio; hilos 0 = todos los del equipo.
+ */
+
+#include "ArchivoOFB.h"
+#include "hexcodec.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+namespace {
+bool leerHex(const char *etiqueta, const char *hex, std::array<uint8_t, 16> &destino) {
+    size_t posicion = 0;
+    if (strlen(hex) == 32 && hexcodec::decode(hex, destino, &posicion)) {
+        return true;
+    }
+    fprintf(stderr, "%s no valida: se esperan 32 digitos hex (error en la posicion %zu)\n",
+            etiqueta, posicion);
+    return false;
+}
+
+int uso() {
+    fprintf(stderr,
+            "uso: ofb_archivo cifrar <clave-hex> <entrada> <salida> [hilos] [vi-hex]\n"
+            "     ofb_archivo descifrar <clave-hex> <entrada> <salida> [hilos]\n"
+            "     ofb_archivo rango <clave-hex> <cifrado> <desplazamiento> <longitud>\n");
+    return 2;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 5) {
+        return uso();
+    }
+    const char *orden = argv[1];
+    std::array<uint8_t, 16> clave{};
+    if (!leerHex("Clave", argv[2], clave)) {
+        return 2;
+    }
+    ArchivoOFB archivo(clave);
+
+    if (strcmp(orden, "rango") == 0) {
+        if (argc != 6) {
+            return uso();
+        }
+        const uint64_t desplazamiento = strtoull(argv[4], nullptr, 10);
+        std::vector<uint8_t> datos(strtoull(argv[5], nullptr, 10));
+        if (!archivo.descifrarRango(argv[3], desplazamiento, datos.data(), datos.size())) {
+            fprintf(stderr, "error: %s\n", archivo.error());
+            return 1;
+        }
+        fwrite(datos.data(), 1, datos.size(), stdout);
+        return 0;
+    }
+
+    const bool cifrar = strcmp(orden, "cifrar") == 0;
+    if (!cifrar && strcmp(orden, "descifrar") != 0) {
+        return uso();
+    }
+    if (argc > 5) {
+        archivo.usarHilos(static_cast<unsigned>(strtoul(argv[5], nullptr, 10)));
+    }
+
+    const auto inicio = std::chrono::steady_clock::now();
+    bool correcto = false;
+    if (cifrar) {
+        std::array<uint8_t, 16> vi{};
+        if (argc > 6) {
+            if (!leerHex("VI", argv[6], vi)) {
+                return 2;
+            }
+        } else {
+            std::random_device aleatorio;
+            for (auto &byte : vi) {
+                byte = static_cast<uint8_t>(aleatorio());
+            }
+        }
+        correcto = archivo.cifrar(argv[3], argv[4], vi);
+    } else {
+        correcto = archivo.descifrar(argv[3], argv[4]);
+    }
+    if (!correcto) {
+        fprintf(stderr, "error: %s\n", archivo.error());
+        return 1;
+    }
+    const double segundos =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    fprintf(stderr, "%s en %.3f s\n", cifrar ? "cifrado" : "descifrado", segundos);
+    return 0;
+}
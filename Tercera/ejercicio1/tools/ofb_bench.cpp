@@ -0,0 +1,47 @@
+/* Host benchmark: bulk keystream generation of the custom OFB cipher with
+ * the scalar (compile-time unrolled) path vs. the SIMD one selected at
+ * runtime, and a check that both produce the same keystream.
+ *
+ * Build (from Tercera/ejercicio1):
+ *   g++ -std=c++17 -O2 -Iinclude tools/ofb_bench.cpp src/CifradorOFB.cpp -o ofb_bench
+ */
+
+#include "CifradorOFB.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+double medirMBs(std::vector<uint8_t> &buffer, int repeticiones) {
+    const std::array<uint8_t, 16> clave = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+                                           0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF};
+    cifradorOFB ofb(clave, {});
+    const auto inicio = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeticiones; ++i) {
+        ofb.generarBloques(buffer.data(), buffer.size() / cifradorOFB::kBloque);
+    }
+    const double segundos =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    return segundos > 0 ? repeticiones * static_cast<double>(buffer.size()) / segundos / 1e6 : 0.0;
+}
+} // namespace
+
+int main() {
+    const int repeticiones = 1000;
+    std::vector<uint8_t> escalar(64 * 1024);
+    std::vector<uint8_t> simd(escalar.size());
+
+    cifradorOFB::usarEscalar(true);
+    const double mbsEscalar = medirMBs(escalar, repeticiones);
+    cifradorOFB::usarEscalar(false);
+    const double mbsSimd = medirMBs(simd, repeticiones);
+
+    std::printf("escalar: %8.1f MB/s\n", mbsEscalar);
+    std::printf("%-8s %8.1f MB/s (x%.2f)\n", (std::string(cifradorOFB::implementacion()) + ":").c_str(), mbsSimd,
+                mbsEscalar > 0 ? mbsSimd / mbsEscalar : 0.0);
+    const bool iguales = escalar == simd;
+    std::printf("keystream %s\n", iguales ? "igual" : "DISTINTO");
+    return iguales ? 0 : 1;
+}
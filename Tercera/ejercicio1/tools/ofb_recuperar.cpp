@@ -0,0 +1,105 @@
+/* Host tool: recuperacion de claves del cifrador OFB con texto claro
+ * conocido, por lotes. Genera mensajes con claves y VI aleatorios, de los
+ * que se conoce un prefijo (p. ej. la cabecera de un formato de fichero),
+ * resuelve el lote con 1 hilo y con todos, y mide el tiempo.
+ *
+ * Build (from Tercera/ejercicio1):
+ *   g++ -std=c++17 -O2 -pthread -Iinclude tools/ofb_recuperar.cpp \
+ *       src/RecuperadorClave.cpp src/CifradorOFB.cpp -o ofb_recuperar
+ *
+ * Usage: ofb_recuperar [mensajes] [bytes-conocidos] [sin-vi] [hilos]
+ *   por defecto 4096 mensajes de 256 bytes con 32 bytes conocidos y el VI
+ *   de la cabecera; "sin-vi" = 1 simula mensajes capturados sin cabecera.
+ */
+
+#include "CifradorOFB.h"
+#include "RecuperadorClave.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+
+namespace {
+constexpr size_t kLongitudMensaje = 256;
+
+struct Lote {
+    std::vector<MensajeCapturado> mensajes;
+    std::vector<std::array<uint8_t, 16>> claves;
+};
+
+Lote generarLote(size_t cantidad, size_t conocidos, bool conVI) {
+    std::mt19937_64 aleatorio(20240101);
+    Lote lote;
+    lote.mensajes.resize(cantidad);
+    lote.claves.resize(cantidad);
+    for (size_t i = 0; i < cantidad; ++i) {
+        std::array<uint8_t, 16> vi{};
+        for (auto &byte : lote.claves[i]) {
+            byte = static_cast<uint8_t>(aleatorio());
+        }
+        for (auto &byte : vi) {
+            byte = static_cast<uint8_t>(aleatorio());
+        }
+        std::vector<uint8_t> claro(kLongitudMensaje);
+        for (auto &byte : claro) {
+            byte = static_cast<uint8_t>(aleatorio());
+        }
+
+        cifradorOFB ofb(lote.claves[i], vi);
+        MensajeCapturado &mensaje = lote.mensajes[i];
+        mensaje.cifrado = ofb.procesar(claro);
+        mensaje.conVI = conVI;
+        mensaje.vi = conVI ? vi : std::array<uint8_t, 16>{};
+        mensaje.conocidos.push_back({0, std::vector<uint8_t>(claro.begin(), claro.begin() + conocidos)});
+    }
+    return lote;
+}
+
+void resolver(const Lote &lote, unsigned hilos) {
+    const auto inicio = std::chrono::steady_clock::now();
+    const auto resultados = recuperarClaves(lote.mensajes, hilos);
+    const double segundos =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    size_t correctas = 0;
+    size_t sinResolver = 0;
+    for (size_t i = 0; i < resultados.size(); ++i) {
+        if (!resultados[i].resuelta) {
+            ++sinResolver;
+        } else if (resultados[i].clave == lote.claves[i]) {
+            ++correctas;
+        }
+    }
+    const unsigned ecuaciones = resultados.empty() ? 0 : resultados[0].ecuaciones;
+    const unsigned rango = resultados.empty() ? 0 : resultados[0].rango;
+    printf("%2u hilo(s): %zu/%zu claves correctas, %zu sin resolver | %u ecuaciones, rango %u | "
+           "%.3f s, %.1f us por mensaje, %.0f mensajes/s\n",
+           hilos, correctas, resultados.size(), sinResolver, ecuaciones, rango, segundos,
+           segundos * 1e6 / resultados.size(), resultados.size() / segundos);
+}
+} // namespace
+
+int main(int argc, char **argv) {
+    const size_t cantidad = argc > 1 ? strtoul(argv[1], nullptr, 10) : 4096;
+    size_t conocidos = argc > 2 ? strtoul(argv[2], nullptr, 10) : 32;
+    const bool conVI = !(argc > 3 && atoi(argv[3]) != 0);
+    unsigned hilos = argc > 4 ? static_cast<unsigned>(strtoul(argv[4], nullptr, 10))
+                              : std::thread::hardware_concurrency();
+    if (conocidos > kLongitudMensaje) {
+        conocidos = kLongitudMensaje;
+    }
+    if (hilos == 0) {
+        hilos = 1;
+    }
+
+    printf("%zu mensajes de %zu bytes, %zu bytes de texto claro conocidos, %s\n", cantidad,
+           kLongitudMensaje, conocidos, conVI ? "VI de la cabecera" : "VI desconocido");
+    const Lote lote = generarLote(cantidad, conocidos, conVI);
+    resolver(lote, 1);
+    if (hilos > 1) {
+        resolver(lote, hilos);
+    }
+    return 0;
+}
@@ -2,19 +2,49 @@
 #define CBCMAC_H
 
 #include <stdint.h>
+#include <stddef.h>
 #include <string>
 #include <array>
 
+#include "aes.h"
+
 class CBCMAC {
 public:
-    // key: must be 16 bytes (AES-128)
+    // key: must be 16 bytes (AES-128). The key schedule is expanded once here.
     CBCMAC(const uint8_t key[16]);
-    // Compute MAC of a file; returns MAC as 16-byte array
-    std::array<uint8_t, 16> computeMAC(const std::string& filepath);
+    // Use a precomputed schedule, e.g. a constexpr AES_make_ctx() result in
+    // flash (see aes_constexpr.h). It is referenced, not copied, so it must
+    // outlive this object.
+    explicit CBCMAC(const AES_ctx& schedule);
+    // A temporary schedule would dangle as soon as the constructor returns
+    CBCMAC(const AES_ctx&&) = delete;
+    CBCMAC(const CBCMAC& other);
+    CBCMAC& operator=(const CBCMAC& other);
+
+    // Incremental interface: feed any number of bytes, then call final().
+    // final() returns the MAC and leaves the object ready for a new message.
+    void update(const uint8_t* data, size_t length);
+    std::array<uint8_t, 16> final();
+    void reset();
+
+    // Compute MAC of an in-memory buffer
+    std::array<uint8_t, 16> computeMAC(const uint8_t* data, size_t length);
+    // Compute MAC of a file into `mac`. Returns false (and leaves `mac`
+    // untouched) if the file cannot be opened or a read fails.
+    bool computeMAC(const std::string& filepath, std::array<uint8_t, 16>& mac);
     // Save a MAC (in hex) to a filename. Returns true if successful.
     bool saveMACHex(const std::array<uint8_t, 16>& mac, const std::string& outPath);
+    // Constant-time comparison of two MACs (no early exit on first mismatch).
+    static bool equals(const std::array<uint8_t, 16>& a, const std::array<uint8_t, 16>& b);
+
 private:
-    uint8_t key_[16];
+    AES_ctx ownCtx_;        // used when constructed from a raw key
+    const AES_ctx* ctx_;    // &ownCtx_ or the caller's schedule
+    uint8_t chain_[16];
+    uint8_t pending_[16];
+    size_t pendingLen_;
+
+    void processBlocks(const uint8_t* data, size_t blocks);
 };
 
 #endif // CBCMAC_H
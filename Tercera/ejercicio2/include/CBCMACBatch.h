@@ -0,0 +1,87 @@
+#ifndef CBCMACBATCH_H
+#define CBCMACBATCH_H
+
+// Batch CBC-MAC over many files (host only).
+// CBC-MAC is sequential inside one file, so the parallelism is across files:
+// every worker owns a CBCMAC (key schedule expanded once per worker) and
+// files are spread over per-worker queues with work stealing.
+
+#ifndef ARDUINO
+
+#include <stdint.h>
+#include <array>
+#include <string>
+#include <vector>
+
+enum class MACMode {
+    CBC,    // CBCMAC (default, matches saveMACHex output of main.cpp)
+    PMAC,   // PMAC1, see PMAC.h
+};
+
+struct MACEntry {
+    std::string path;
+    uint64_t size;
+    int64_t mtime;      // last write time, only compared for equality
+    std::array<uint8_t, 16> mac;
+    bool ok;
+};
+
+enum class VerifyStatus {
+    Unchanged,  // size and mtime match the cache, file not reread
+    Verified,   // metadata changed, MAC recomputed and still matches
+    Modified,   // MAC recomputed and differs from the cache
+    Missing,    // in the cache but no longer on disk
+    Added,      // on disk but not in the cache
+};
+
+enum class CacheLoad {
+    Ok,
+    NotFound,   // no cache file yet: start a new one
+    Unreadable, // exists but cannot be opened
+    BadHeader,  // first line is not a mac-cache v1 header
+    WrongMode,  // cache was built with the other MACMode
+    BadLine,    // an entry line does not parse
+};
+
+struct VerifyEntry {
+    std::string path;
+    VerifyStatus status;
+};
+
+// Recursively list the regular files under root, sorted by path.
+std::vector<std::string> listFilesRecursive(const std::string& root);
+
+// MAC every path using up to `threads` workers (0 = hardware concurrency).
+// The result keeps the order of `paths`.
+std::vector<MACEntry> computeMACBatch(const uint8_t key[16],
+                                      const std::vector<std::string>& paths,
+                                      unsigned threads = 0,
+                                      MACMode mode = MACMode::CBC);
+
+// Write one line per entry: the MAC in saveMACHex format, two spaces, path.
+bool saveManifestHex(const std::vector<MACEntry>& entries, const std::string& outPath);
+
+// Manifest cache: like saveManifestHex but each line also carries the size
+// and mtime the MAC was computed for ("<mac hex> <size> <mtime>  <path>").
+// The first line records the MAC mode so caches of both modes are not mixed.
+// Only CacheLoad::NotFound means there is no baseline; every other failure
+// means the existing cache must not be trusted or overwritten.
+bool saveManifestCache(const std::vector<MACEntry>& entries, MACMode mode, const std::string& outPath);
+CacheLoad loadManifestCache(const std::string& inPath, MACMode mode, std::vector<MACEntry>& entries);
+const char* cacheLoadMessage(CacheLoad result);
+
+// Verify every file under root against `cache`. Files whose size and mtime
+// match are skipped unless `full` is set; the rest are recomputed on the pool
+// and compared in constant time. `cache` is updated in place: metadata of
+// verified files is refreshed and added files are appended, but the stored
+// MAC of a modified file is kept so it keeps failing until re-approved.
+std::vector<VerifyEntry> verifyMACBatch(const uint8_t key[16],
+                                        const std::string& root,
+                                        std::vector<MACEntry>& cache,
+                                        unsigned threads = 0,
+                                        MACMode mode = MACMode::CBC,
+                                        bool full = false);
+
+#endif // ARDUINO
+
+#endif // CBCMACBATCH_H
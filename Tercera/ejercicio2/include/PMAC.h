@@ -0,0 +1,50 @@
+#ifndef PMAC_H
+#define PMAC_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <array>
+
+#include "aes.h"
+
+// PMAC1 (Rogaway) over AES-128: a parallelizable alternative to CBCMAC.
+// Every block is encrypted independently under its own offset, so one large
+// message can be split into ranges that are MAC-ed on different cores and
+// combined with XOR. Tags are NOT interchangeable with CBCMAC tags.
+class PMAC {
+public:
+    // key: must be 16 bytes (AES-128)
+    PMAC(const uint8_t key[16]);
+
+    // Incremental interface, same contract as CBCMAC::update()/final().
+    void update(const uint8_t* data, size_t length);
+    std::array<uint8_t, 16> final();
+    void reset();
+
+    // Compute MAC of an in-memory buffer
+    std::array<uint8_t, 16> computeMAC(const uint8_t* data, size_t length);
+    // Compute MAC of a file into `mac`. On the host the file is split across
+    // `threads` workers (0 = hardware concurrency); on the board it is
+    // streamed. Returns false (and leaves `mac` untouched) on open/read errors.
+    bool computeMAC(const std::string& filepath, std::array<uint8_t, 16>& mac, unsigned threads = 0);
+
+private:
+    AES_ctx ctx_;
+    uint8_t L_[64][16];     // L * x^i
+    uint8_t Linv_[16];      // L * x^-1
+    uint8_t offset_[16];
+    uint8_t sigma_[16];
+    uint8_t pending_[16];
+    size_t pendingLen_;
+    uint64_t blockIndex_;   // number of body blocks absorbed so far
+
+    // XOR E(M_i ^ Offset_i) into sigma for `blocks` blocks starting at
+    // 1-based index first+1; `offset` must hold Offset_first on entry.
+    void absorb(const uint8_t* data, size_t blocks, uint64_t first,
+                uint8_t offset[16], uint8_t sigma[16]) const;
+    void offsetAt(uint64_t index, uint8_t offset[16]) const;
+    std::array<uint8_t, 16> finish(uint8_t sigma[16], const uint8_t* last, size_t lastLen) const;
+};
+
+#endif // PMAC_H
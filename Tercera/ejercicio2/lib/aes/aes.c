@@ -110,7 +110,7 @@ void AES_init_ctx(struct AES_ctx* ctx, const uint8_t* key){
     KeyExpansion(ctx->RoundKey, key);
 }
 
-void AES_ECB_encrypt(struct AES_ctx* ctx, uint8_t* buf){
+void AES_ECB_encrypt(const struct AES_ctx* ctx, uint8_t* buf){
     uint8_t state[16];
     for (int i = 0; i < 16; ++i) state[i] = buf[i];
     AddRoundKey(state, ctx->RoundKey);
@@ -126,4 +126,9 @@ void AES_ECB_encrypt(struct AES_ctx* ctx, uint8_t* buf){
     for (int i = 0; i < 16; ++i) buf[i] = state[i];
 }
 
+void AES_ECB_encrypt_blocks(const struct AES_ctx* ctx, uint8_t* buf, size_t blocks){
+    for (size_t b = 0; b < blocks; ++b)
+        AES_ECB_encrypt(ctx, buf + b*16);
+}
+
 // End of AES
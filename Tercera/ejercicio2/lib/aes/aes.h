@@ -8,11 +8,21 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 struct AES_ctx {
     uint8_t RoundKey[176];
 };
 
 void AES_init_ctx(struct AES_ctx* ctx, const uint8_t* key);
-void AES_ECB_encrypt(struct AES_ctx* ctx, uint8_t* buf);
+void AES_ECB_encrypt(const struct AES_ctx* ctx, uint8_t* buf);
+// Encrypt `blocks` independent 16-byte blocks stored back to back in buf.
+void AES_ECB_encrypt_blocks(const struct AES_ctx* ctx, uint8_t* buf, size_t blocks);
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif // AES_H
@@ -0,0 +1,90 @@
+/* Compile-time AES-128 key expansion (C++ only).
+ * Same schedule as KeyExpansion() in aes.c, but usable in constant
+ * expressions, so a fixed key can be expanded by the compiler:
+ *
+ *     static constexpr uint8_t kKey[16] = { ... };
+ *     static constexpr AES_ctx kCtx = AES_make_ctx(kKey);
+ *
+ * A constexpr object with static storage is placed in read-only data
+ * (flash on the ESP32), so there is no startup cost and no RAM copy.
+ */
+#ifndef AES_CONSTEXPR_H
+#define AES_CONSTEXPR_H
+
+#include <stdint.h>
+#include "aes.h"
+
+namespace aes_constexpr {
+
+struct SBox {
+    uint8_t v[256];
+};
+
+constexpr uint8_t rotl8(uint8_t x, int s){
+    return static_cast<uint8_t>((x << s) | (x >> (8 - s)));
+}
+
+// Build the S-box by walking GF(2^8) with generator 3 and its inverse,
+// then applying the affine transform (no 256-byte table to keep in sync).
+constexpr SBox makeSBox(){
+    SBox box{};
+    uint8_t p = 1, q = 1;
+    do {
+        p = static_cast<uint8_t>(p ^ (p << 1) ^ ((p & 0x80) ? 0x1B : 0));
+        q = static_cast<uint8_t>(q ^ (q << 1));
+        q = static_cast<uint8_t>(q ^ (q << 2));
+        q = static_cast<uint8_t>(q ^ (q << 4));
+        if (q & 0x80) q ^= 0x09;
+        uint8_t x = static_cast<uint8_t>(q ^ rotl8(q, 1) ^ rotl8(q, 2) ^ rotl8(q, 3) ^ rotl8(q, 4));
+        box.v[p] = static_cast<uint8_t>(x ^ 0x63);
+    } while (p != 1);
+    box.v[0] = 0x63;
+    return box;
+}
+
+constexpr SBox kSBox = makeSBox();
+
+} // namespace aes_constexpr
+
+// Portable layout: the 176 round-key bytes used by AES_ECB_encrypt().
+constexpr AES_ctx AES_make_ctx(const uint8_t (&key)[16]){
+    AES_ctx ctx{};
+    const uint8_t rcon[11] = {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36};
+    for (int i = 0; i < 16; ++i) ctx.RoundKey[i] = key[i];
+    for (int i = 16, j = 1; i < 176; ) {
+        uint8_t temp[4] = {ctx.RoundKey[i - 4], ctx.RoundKey[i - 3],
+                           ctx.RoundKey[i - 2], ctx.RoundKey[i - 1]};
+        if (i % 16 == 0) {
+            uint8_t t = temp[0];
+            temp[0] = static_cast<uint8_t>(aes_constexpr::kSBox.v[temp[1]] ^ rcon[j]);
+            temp[1] = aes_constexpr::kSBox.v[temp[2]];
+            temp[2] = aes_constexpr::kSBox.v[temp[3]];
+            temp[3] = aes_constexpr::kSBox.v[t];
+            ++j;
+        }
+        for (int k = 0; k < 4; ++k, ++i) {
+            ctx.RoundKey[i] = static_cast<uint8_t>(ctx.RoundKey[i - 16] ^ temp[k]);
+        }
+    }
+    return ctx;
+}
+
+// T-table layout: the same schedule as 44 big-endian 32-bit words
+// (w[4r+c] = column c of round key r), as consumed by table-driven AES.
+struct AES_ctx_words {
+    uint32_t w[44];
+};
+
+constexpr AES_ctx_words AES_make_ctx_words(const uint8_t (&key)[16]){
+    AES_ctx bytes = AES_make_ctx(key);
+    AES_ctx_words words{};
+    for (int i = 0; i < 44; ++i) {
+        words.w[i] = (static_cast<uint32_t>(bytes.RoundKey[4 * i]) << 24) |
+                     (static_cast<uint32_t>(bytes.RoundKey[4 * i + 1]) << 16) |
+                     (static_cast<uint32_t>(bytes.RoundKey[4 * i + 2]) << 8) |
+                     static_cast<uint32_t>(bytes.RoundKey[4 * i + 3]);
+    }
+    return words;
+}
+
+#endif // AES_CONSTEXPR_H
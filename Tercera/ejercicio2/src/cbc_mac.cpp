@@ -1,58 +1,147 @@
 #include "CBCMAC.h"
 #include "aes.h"
+#include "hexcodec.h"
 #include <cstdio>
 #include <cstring>
+#include <memory>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
 
-CBCMAC::CBCMAC(const uint8_t key[16]){
-    memcpy(key_, key, 16);
+// File reads are done in large chunks (a multiple of the AES block size) so
+// the MAC loop consumes whole buffers instead of one fread() per block.
+#ifdef ARDUINO
+static const size_t kReadChunk = 4096;
+#else
+static const size_t kReadChunk = 64 * 1024;
+#endif
+
+CBCMAC::CBCMAC(const uint8_t key[16]) : ctx_(&ownCtx_){
+    AES_init_ctx(&ownCtx_, key);
+    reset();
+}
+
+CBCMAC::CBCMAC(const AES_ctx& schedule) : ctx_(&schedule){
+    reset();
+}
+
+CBCMAC::CBCMAC(const CBCMAC& other){
+    *this = other;
+}
+
+CBCMAC& CBCMAC::operator=(const CBCMAC& other){
+    if (this == &other) return *this;
+    // Keep pointing at our own copy when the source owned its schedule
+    if (other.ctx_ == &other.ownCtx_) {
+        ownCtx_ = other.ownCtx_;
+        ctx_ = &ownCtx_;
+    } else {
+        ctx_ = other.ctx_;
+    }
+    memcpy(chain_, other.chain_, sizeof(chain_));
+    memcpy(pending_, other.pending_, sizeof(pending_));
+    pendingLen_ = other.pendingLen_;
+    return *this;
 }
 
-static void xor_block(uint8_t out[16], const uint8_t a[16], const uint8_t b[16]){
-    for (int i = 0; i < 16; ++i) out[i] = a[i] ^ b[i];
+void CBCMAC::reset(){
+    memset(chain_, 0, sizeof(chain_));
+    memset(pending_, 0, sizeof(pending_));
+    pendingLen_ = 0;
+}
+
+void CBCMAC::processBlocks(const uint8_t* data, size_t blocks){
+    for (size_t b = 0; b < blocks; ++b, data += 16) {
+        for (int i = 0; i < 16; ++i) chain_[i] ^= data[i];
+        AES_ECB_encrypt(ctx_, chain_);
+    }
+}
+
+void CBCMAC::update(const uint8_t* data, size_t length){
+    if (data == nullptr || length == 0) return;
+
+    // Complete a partially filled block first
+    if (pendingLen_ > 0) {
+        size_t take = 16 - pendingLen_;
+        if (take > length) take = length;
+        memcpy(pending_ + pendingLen_, data, take);
+        pendingLen_ += take;
+        data += take;
+        length -= take;
+        if (pendingLen_ < 16) return;
+        processBlocks(pending_, 1);
+        pendingLen_ = 0;
+    }
+
+    // Whole blocks straight from the caller's buffer, no copy
+    size_t blocks = length / 16;
+    processBlocks(data, blocks);
+    data += blocks * 16;
+    length -= blocks * 16;
+
+    if (length > 0) {
+        memcpy(pending_, data, length);
+        pendingLen_ = length;
+    }
 }
 
-std::array<uint8_t, 16> CBCMAC::computeMAC(const std::string& filepath){
+std::array<uint8_t, 16> CBCMAC::final(){
+    if (pendingLen_ > 0) {
+        // PKCS#7 padding (only for a trailing partial block)
+        uint8_t pad = static_cast<uint8_t>(16 - pendingLen_);
+        for (size_t i = pendingLen_; i < 16; ++i) pending_[i] = pad;
+        processBlocks(pending_, 1);
+    }
     std::array<uint8_t, 16> mac{};
-    uint8_t iv[16] = {0};
-    uint8_t block[16];
-    uint8_t xorbuf[16];
-    AES_ctx ctx;
-    AES_init_ctx(&ctx, key_);
+    memcpy(mac.data(), chain_, 16);
+    reset();
+    return mac;
+}
+
+std::array<uint8_t, 16> CBCMAC::computeMAC(const uint8_t* data, size_t length){
+    reset();
+    update(data, length);
+    return final();
+}
+
+bool CBCMAC::computeMAC(const std::string& filepath, std::array<uint8_t, 16>& mac){
+    reset();
 
     FILE* f = fopen(filepath.c_str(), "rb");
-    if (!f) {
-        // Return MAC all-zero if failed to open file
-        return mac;
-    }
+    if (!f) return false;
+    // We already read in big chunks; skip the stdio buffer copy
+    setvbuf(f, nullptr, _IONBF, 0);
 
+    std::unique_ptr<uint8_t[]> chunk(new uint8_t[kReadChunk]);
     while (true) {
-        size_t n = fread(block, 1, 16, f);
+        size_t n = fread(chunk.get(), 1, kReadChunk, f);
         if (n == 0) break; // EOF
-        if (n < 16) {
-            // PKCS#7 padding
-            uint8_t pad = 16 - n;
-            for (size_t i = n; i < 16; ++i) block[i] = pad;
-        }
-        xor_block(xorbuf, block, iv);
-        AES_ECB_encrypt(&ctx, xorbuf);
-        memcpy(iv, xorbuf, 16);
-        if (n < 16) break; // this was last block
+        update(chunk.get(), n);
     }
+    // fread() also returns 0 on a read error: only a clean EOF is a MAC
+    bool readOk = !ferror(f);
     fclose(f);
-    memcpy(mac.data(), iv, 16);
-    return mac;
+    if (!readOk) {
+        reset();
+        return false;
+    }
+    mac = final();
+    return true;
 }
 
 bool CBCMAC::saveMACHex(const std::array<uint8_t, 16>& mac, const std::string& outPath){
     FILE* f = fopen(outPath.c_str(), "wb");
     if (!f) return false;
-    for (int i = 0; i < 16; ++i) {
-        fprintf(f, "%02x", mac[i]);
-    }
-    fprintf(f, "\n");
+    char line[33];
+    hexcodec::encode(mac.data(), mac.size(), line);
+    line[32] = '\n';
+    fwrite(line, 1, sizeof(line), f);
     fclose(f);
     return true;
 }
+
+bool CBCMAC::equals(const std::array<uint8_t, 16>& a, const std::array<uint8_t, 16>& b){
+    volatile uint8_t diff = 0;
+    for (int i = 0; i < 16; ++i) diff |= a[i] ^ b[i];
+    return diff == 0;
+}
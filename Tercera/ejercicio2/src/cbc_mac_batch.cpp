@@ -0,0 +1,284 @@
+#ifndef ARDUINO
+
+#include "CBCMACBatch.h"
+#include "CBCMAC.h"
+#include "PMAC.h"
+#include "hexcodec.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// One queue per worker. The owner takes from the front, thieves from the back.
+struct WorkQueue {
+    std::mutex lock;
+    std::deque<size_t> items;
+
+    bool popFront(size_t& out){
+        std::lock_guard<std::mutex> g(lock);
+        if (items.empty()) return false;
+        out = items.front();
+        items.pop_front();
+        return true;
+    }
+
+    bool stealBack(size_t& out){
+        std::lock_guard<std::mutex> g(lock);
+        if (items.empty()) return false;
+        out = items.back();
+        items.pop_back();
+        return true;
+    }
+};
+
+bool statFile(const std::string& path, uint64_t& size, int64_t& mtime){
+    std::error_code ec;
+    size = fs::file_size(path, ec);
+    if (ec) return false;
+    auto t = fs::last_write_time(path, ec);
+    if (ec) return false;
+    mtime = static_cast<int64_t>(t.time_since_epoch().count());
+    return true;
+}
+
+const char* modeName(MACMode mode){
+    return mode == MACMode::PMAC ? "pmac" : "cbc";
+}
+
+} // namespace
+
+std::vector<std::string> listFilesRecursive(const std::string& root){
+    std::vector<std::string> files;
+    std::error_code ec;
+    for (fs::recursive_directory_iterator it(root, fs::directory_options::skip_permission_denied, ec), end;
+         !ec && it != end; it.increment(ec)) {
+        if (it->is_regular_file(ec)) files.push_back(it->path().string());
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+std::vector<MACEntry> computeMACBatch(const uint8_t key[16],
+                                      const std::vector<std::string>& paths,
+                                      unsigned threads,
+                                      MACMode mode){
+    std::vector<MACEntry> entries(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        entries[i].path = paths[i];
+        entries[i].ok = statFile(paths[i], entries[i].size, entries[i].mtime);
+        if (!entries[i].ok) {
+            entries[i].size = 0;
+            entries[i].mtime = 0;
+        }
+        entries[i].mac.fill(0);
+    }
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    if (threads > paths.size()) threads = static_cast<unsigned>(std::max<size_t>(1, paths.size()));
+
+    // Largest files first, dealt round-robin: every worker starts on a big
+    // file and ends with small ones, which are also what thieves pick up.
+    std::vector<size_t> order(paths.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b){
+        return entries[a].size > entries[b].size;
+    });
+
+    std::vector<WorkQueue> queues(threads);
+    for (size_t i = 0; i < order.size(); ++i) {
+        queues[i % threads].items.push_back(order[i]);
+    }
+
+    const CBCMAC cbcPrototype(key);
+    const PMAC pmacPrototype(key);
+    auto worker = [&](unsigned self){
+        CBCMAC cbc = cbcPrototype;
+        PMAC pmac = pmacPrototype;
+        size_t idx;
+        while (true) {
+            bool found = queues[self].popFront(idx);
+            for (unsigned k = 1; !found && k < threads; ++k) {
+                found = queues[(self + k) % threads].stealBack(idx);
+            }
+            if (!found) return; // nothing is ever enqueued again
+            if (!entries[idx].ok) continue;
+            // Files are already spread over the pool: PMAC runs single-threaded here.
+            // A file that vanished or became unreadable after the stat is
+            // reported like a stat failure instead of getting a bogus MAC.
+            entries[idx].ok = mode == MACMode::PMAC ? pmac.computeMAC(entries[idx].path, entries[idx].mac, 1)
+                                                    : cbc.computeMAC(entries[idx].path, entries[idx].mac);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& th : pool) th.join();
+    return entries;
+}
+
+bool saveManifestHex(const std::vector<MACEntry>& entries, const std::string& outPath){
+    FILE* f = fopen(outPath.c_str(), "wb");
+    if (!f) return false;
+    char hex[32];
+    for (const auto& e : entries) {
+        if (!e.ok) continue;
+        hexcodec::encode(e.mac.data(), e.mac.size(), hex);
+        fwrite(hex, 1, sizeof(hex), f);
+        fprintf(f, "  %s\n", e.path.c_str());
+    }
+    return fclose(f) == 0;
+}
+
+bool saveManifestCache(const std::vector<MACEntry>& entries, MACMode mode, const std::string& outPath){
+    FILE* f = fopen(outPath.c_str(), "wb");
+    if (!f) return false;
+    fprintf(f, "# mac-cache v1 %s\n", modeName(mode));
+    char hex[32];
+    for (const auto& e : entries) {
+        if (!e.ok) continue;
+        hexcodec::encode(e.mac.data(), e.mac.size(), hex);
+        fwrite(hex, 1, sizeof(hex), f);
+        fprintf(f, " %llu %lld  %s\n", static_cast<unsigned long long>(e.size),
+                static_cast<long long>(e.mtime), e.path.c_str());
+    }
+    return fclose(f) == 0;
+}
+
+CacheLoad loadManifestCache(const std::string& inPath, MACMode mode, std::vector<MACEntry>& entries){
+    entries.clear();
+    FILE* f = fopen(inPath.c_str(), "rb");
+    if (!f) return errno == ENOENT ? CacheLoad::NotFound : CacheLoad::Unreadable;
+
+    char header[64] = "";
+    char expected[64];
+    const MACMode other = mode == MACMode::PMAC ? MACMode::CBC : MACMode::PMAC;
+    snprintf(expected, sizeof(expected), "# mac-cache v1 %s\n", modeName(other));
+    if (!fgets(header, sizeof(header), f) && ferror(f)) {
+        fclose(f);
+        return CacheLoad::Unreadable;
+    }
+    if (strcmp(header, expected) == 0) {
+        fclose(f);
+        return CacheLoad::WrongMode;
+    }
+    snprintf(expected, sizeof(expected), "# mac-cache v1 %s\n", modeName(mode));
+    if (strcmp(header, expected) != 0) {
+        fclose(f);
+        return CacheLoad::BadHeader;
+    }
+
+    char line[4096];
+    while (fgets(line, sizeof(line), f)) {
+        size_t len = strlen(line);
+        if (len > 0 && line[len - 1] == '\n') line[--len] = '\0';
+        if (len == 0) continue;
+
+        MACEntry e;
+        unsigned long long size = 0;
+        long long mtime = 0;
+        int pathStart = 0;
+        bool ok = len > 32 &&
+                  hexcodec::decode(line, 32, e.mac.data()) &&
+                  sscanf(line + 32, " %llu %lld  %n", &size, &mtime, &pathStart) == 2 &&
+                  pathStart > 0;
+        if (!ok) {
+            fclose(f);
+            entries.clear();
+            return CacheLoad::BadLine;
+        }
+        e.path = line + 32 + pathStart;
+        e.size = size;
+        e.mtime = mtime;
+        e.ok = true;
+        entries.push_back(e);
+    }
+    bool readOk = !ferror(f);
+    fclose(f);
+    if (!readOk) {
+        entries.clear();
+        return CacheLoad::Unreadable;
+    }
+    return CacheLoad::Ok;
+}
+
+const char* cacheLoadMessage(CacheLoad result){
+    switch (result) {
+    case CacheLoad::Ok:         return "ok";
+    case CacheLoad::NotFound:   return "not found";
+    case CacheLoad::Unreadable: return "cannot be read";
+    case CacheLoad::BadHeader:  return "is not a mac-cache v1 file";
+    case CacheLoad::WrongMode:  return "was built with the other MAC mode (check --pmac)";
+    case CacheLoad::BadLine:    return "has an unparsable entry line";
+    }
+    return "unknown error";
+}
+
+std::vector<VerifyEntry> verifyMACBatch(const uint8_t key[16],
+                                        const std::string& root,
+                                        std::vector<MACEntry>& cache,
+                                        unsigned threads,
+                                        MACMode mode,
+                                        bool full){
+    std::unordered_map<std::string, size_t> byPath;
+    for (size_t i = 0; i < cache.size(); ++i) byPath[cache[i].path] = i;
+
+    std::vector<VerifyEntry> report;
+    std::vector<std::string> suspect;
+    std::vector<char> seen(cache.size(), 0);
+    for (const auto& path : listFilesRecursive(root)) {
+        auto it = byPath.find(path);
+        if (it == byPath.end()) {
+            suspect.push_back(path);
+            continue;
+        }
+        const MACEntry& c = cache[it->second];
+        seen[it->second] = 1;
+        uint64_t size;
+        int64_t mtime;
+        if (!full && statFile(path, size, mtime) && size == c.size && mtime == c.mtime) {
+            report.push_back({path, VerifyStatus::Unchanged});
+        } else {
+            suspect.push_back(path);
+        }
+    }
+    for (size_t i = 0; i < cache.size(); ++i) {
+        if (!seen[i]) report.push_back({cache[i].path, VerifyStatus::Missing});
+    }
+
+    // Only the suspects are reread, still spread over the whole pool
+    for (const auto& e : computeMACBatch(key, suspect, threads, mode)) {
+        if (!e.ok) {
+            report.push_back({e.path, VerifyStatus::Missing});
+            continue;
+        }
+        auto it = byPath.find(e.path);
+        if (it == byPath.end()) {
+            cache.push_back(e);
+            report.push_back({e.path, VerifyStatus::Added});
+        } else if (CBCMAC::equals(cache[it->second].mac, e.mac)) {
+            cache[it->second].size = e.size;
+            cache[it->second].mtime = e.mtime;
+            report.push_back({e.path, VerifyStatus::Verified});
+        } else {
+            report.push_back({e.path, VerifyStatus::Modified});
+        }
+    }
+
+    std::sort(report.begin(), report.end(), [](const VerifyEntry& a, const VerifyEntry& b){
+        return a.path < b.path;
+    });
+    return report;
+}
+
+#endif // ARDUINO
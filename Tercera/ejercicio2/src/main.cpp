@@ -1,41 +1,94 @@
 
 #include "CBCMAC.h"
+#include "PMAC.h"
+#include "aes_constexpr.h"
+#include "hexcodec.h"
 #include <Arduino.h>
+#include <cstring>
 /* Example usage: compute and save CBC-MAC (AES-CBC-MAC) of a file
  * Reads file from project data folder (relative path), computes MAC,
  * prints to serial and saves to a file.
  */
 
+// 16-byte AES key (example). Its CBC-MAC key schedule is expanded at compile
+// time and stored in flash.
+static constexpr uint8_t kKey[16] = {
+    0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,
+    0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x10
+};
+static constexpr AES_ctx kKeySchedule = AES_make_ctx(kKey);
+
+// Published PMAC-AES-128 vectors: key 000102..0f, message 00 01 02 ... (len bytes)
+struct PMACVector {
+    size_t len;
+    const char* tag;
+};
+
+static const PMACVector kPMACVectors[] = {
+    {0,  "4399572cd6ea5341b8d35876a7098af7"},
+    {3,  "256ba5193c1b991b4df0c51f388a9e27"},
+    {16, "ebbd822fa458daf6dfdad7c27da76338"},
+    {20, "0412ca150bbf79058d8c75a58c993f55"},
+    {32, "e97ac04e9e5e3399ce5355cd7407bc75"},
+    {34, "5cba7d5eb24f7c86ccc54604e53d5512"},
+};
+
+static void toHex(const std::array<uint8_t, 16>& mac, char hex[33]){
+    hexcodec::encode(mac.data(), mac.size(), hex);
+    hex[32] = '\0';
+}
+
+static void checkPMACVectors(){
+    uint8_t key[16];
+    uint8_t msg[34];
+    for (int i = 0; i < 16; ++i) key[i] = i;
+    for (int i = 0; i < 34; ++i) msg[i] = i;
+
+    PMAC pmac(key);
+    char hex[33];
+    for (const auto& v : kPMACVectors) {
+        toHex(pmac.computeMAC(msg, v.len), hex);
+        bool ok = strcmp(hex, v.tag) == 0;
+        Serial.printf("PMAC test vector len=%u: %s [%s]\n", (unsigned)v.len, hex, ok ? "OK" : "ERROR");
+    }
+}
+
 void setup(){
     Serial.begin(115200);
     // initialize pin 43 for blinking
     pinMode(43, OUTPUT);
     delay(1000);
 
-    // 16-byte AES key (example)
-    const uint8_t key[16] = {
-        0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,
-        0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x10
-    };
-
-    CBCMAC cbc(key);
+    CBCMAC cbc(kKeySchedule);
     // file path relative to project root (during development)
     const char* inpath = "data/Preguntas_Moodle_20210123.txt";
     const char* outpath = "mac_Preguntas_20210123.txt";
 
-    auto mac = cbc.computeMAC(inpath);
-
-    // Print MAC as hex to Serial
+    std::array<uint8_t, 16> mac;
     char hex[33];
-    for (int i = 0; i < 16; ++i) sprintf(hex + i*2, "%02x", mac[i]);
-    hex[32] = '\0';
-    Serial.printf("MAC(%s) = %s\n", inpath, hex);
+    if (!cbc.computeMAC(inpath, mac)) {
+        Serial.printf("Cannot read %s\n", inpath);
+    } else {
+        // Print MAC as hex to Serial
+        toHex(mac, hex);
+        Serial.printf("MAC(%s) = %s\n", inpath, hex);
+
+        // Save MAC to outpath
+        if (cbc.saveMACHex(mac, outpath)) {
+            Serial.printf("Saved MAC to %s\n", outpath);
+        } else {
+            Serial.printf("Failed to save MAC to %s\n", outpath);
+        }
+    }
 
-    // Save MAC to outpath
-    if (cbc.saveMACHex(mac, outpath)) {
-        Serial.printf("Saved MAC to %s\n", outpath);
+    // Parallelizable alternative, selected explicitly (different tag than CBC-MAC)
+    checkPMACVectors();
+    PMAC pmac(kKey);
+    if (pmac.computeMAC(inpath, mac)) {
+        toHex(mac, hex);
+        Serial.printf("PMAC(%s) = %s\n", inpath, hex);
     } else {
-        Serial.printf("Failed to save MAC to %s\n", outpath);
+        Serial.printf("Cannot read %s\n", inpath);
     }
 }
 
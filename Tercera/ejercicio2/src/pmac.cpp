@@ -0,0 +1,245 @@
+#include "PMAC.h"
+#include "aes.h"
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+#ifndef ARDUINO
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef ARDUINO
+static const size_t kReadChunk = 4096;
+#else
+static const size_t kReadChunk = 64 * 1024;
+#endif
+
+// Blocks handed to the AES backend per call
+static const size_t kBatchBlocks = 8;
+
+// Multiply by x in GF(2^128) (big-endian, polynomial x^128 + x^7 + x^2 + x + 1)
+static void gf_double(uint8_t out[16], const uint8_t in[16]){
+    uint8_t carry = in[0] >> 7;
+    for (int i = 0; i < 15; ++i) out[i] = static_cast<uint8_t>((in[i] << 1) | (in[i + 1] >> 7));
+    out[15] = static_cast<uint8_t>((in[15] << 1) ^ (carry ? 0x87 : 0x00));
+}
+
+// Multiply by x^-1 in GF(2^128)
+static void gf_halve(uint8_t out[16], const uint8_t in[16]){
+    uint8_t carry = in[15] & 1;
+    for (int i = 15; i > 0; --i) out[i] = static_cast<uint8_t>((in[i] >> 1) | (in[i - 1] << 7));
+    out[0] = static_cast<uint8_t>(in[0] >> 1);
+    if (carry) {
+        out[0] ^= 0x80;
+        out[15] ^= 0x43;
+    }
+}
+
+static void xor_into(uint8_t dst[16], const uint8_t src[16]){
+    for (int i = 0; i < 16; ++i) dst[i] ^= src[i];
+}
+
+PMAC::PMAC(const uint8_t key[16]){
+    AES_init_ctx(&ctx_, key);
+    uint8_t L[16] = {0};
+    AES_ECB_encrypt(&ctx_, L);
+    memcpy(L_[0], L, 16);
+    for (int i = 1; i < 64; ++i) gf_double(L_[i], L_[i - 1]);
+    gf_halve(Linv_, L);
+    reset();
+}
+
+void PMAC::reset(){
+    memset(offset_, 0, sizeof(offset_));
+    memset(sigma_, 0, sizeof(sigma_));
+    memset(pending_, 0, sizeof(pending_));
+    pendingLen_ = 0;
+    blockIndex_ = 0;
+}
+
+void PMAC::offsetAt(uint64_t index, uint8_t offset[16]) const {
+    // Offset_i is the XOR of L(ntz(j)) for j = 1..i, i.e. the sum of L(b)
+    // over the set bits b of the Gray code of i.
+    memset(offset, 0, 16);
+    uint64_t gray = index ^ (index >> 1);
+    for (int b = 0; gray != 0; ++b, gray >>= 1) {
+        if (gray & 1) xor_into(offset, L_[b]);
+    }
+}
+
+void PMAC::absorb(const uint8_t* data, size_t blocks, uint64_t first,
+                  uint8_t offset[16], uint8_t sigma[16]) const {
+    uint8_t batch[kBatchBlocks * 16];
+    while (blocks > 0) {
+        size_t n = blocks < kBatchBlocks ? blocks : kBatchBlocks;
+        for (size_t j = 0; j < n; ++j) {
+            xor_into(offset, L_[__builtin_ctzll(++first)]);
+            for (int i = 0; i < 16; ++i) batch[j * 16 + i] = data[j * 16 + i] ^ offset[i];
+        }
+        AES_ECB_encrypt_blocks(&ctx_, batch, n);
+        for (size_t j = 0; j < n; ++j) xor_into(sigma, batch + j * 16);
+        data += n * 16;
+        blocks -= n;
+    }
+}
+
+std::array<uint8_t, 16> PMAC::finish(uint8_t sigma[16], const uint8_t* last, size_t lastLen) const {
+    if (lastLen == 16) {
+        xor_into(sigma, last);
+        xor_into(sigma, Linv_);
+    } else {
+        // 10* padding of a short (possibly empty) final block
+        for (size_t i = 0; i < lastLen; ++i) sigma[i] ^= last[i];
+        sigma[lastLen] ^= 0x80;
+    }
+    AES_ECB_encrypt(&ctx_, sigma);
+    std::array<uint8_t, 16> tag{};
+    memcpy(tag.data(), sigma, 16);
+    return tag;
+}
+
+void PMAC::update(const uint8_t* data, size_t length){
+    if (data == nullptr || length == 0) return;
+
+    if (pendingLen_ < 16) {
+        size_t take = 16 - pendingLen_;
+        if (take > length) take = length;
+        memcpy(pending_ + pendingLen_, data, take);
+        pendingLen_ += take;
+        data += take;
+        length -= take;
+        if (length == 0) return;
+    }
+
+    // The held-back block is full and more data follows: it is not the last
+    absorb(pending_, 1, blockIndex_, offset_, sigma_);
+    ++blockIndex_;
+
+    // Keep the final 1..16 bytes back, the last block is treated specially
+    size_t blocks = (length - 1) / 16;
+    absorb(data, blocks, blockIndex_, offset_, sigma_);
+    blockIndex_ += blocks;
+    data += blocks * 16;
+    length -= blocks * 16;
+
+    memcpy(pending_, data, length);
+    pendingLen_ = length;
+}
+
+std::array<uint8_t, 16> PMAC::final(){
+    auto tag = finish(sigma_, pending_, pendingLen_);
+    reset();
+    return tag;
+}
+
+std::array<uint8_t, 16> PMAC::computeMAC(const uint8_t* data, size_t length){
+    reset();
+    update(data, length);
+    return final();
+}
+
+#ifdef ARDUINO
+bool PMAC::computeMAC(const std::string& filepath, std::array<uint8_t, 16>& mac, unsigned threads){
+    (void)threads;
+    reset();
+
+    FILE* f = fopen(filepath.c_str(), "rb");
+    if (!f) return false;
+    setvbuf(f, nullptr, _IONBF, 0);
+
+    std::unique_ptr<uint8_t[]> chunk(new uint8_t[kReadChunk]);
+    while (true) {
+        size_t n = fread(chunk.get(), 1, kReadChunk, f);
+        if (n == 0) break; // EOF
+        update(chunk.get(), n);
+    }
+    // fread() also returns 0 on a read error: only a clean EOF is a MAC
+    bool readOk = !ferror(f);
+    fclose(f);
+    if (!readOk) {
+        reset();
+        return false;
+    }
+    mac = final();
+    return true;
+}
+#else
+static bool read_full(int fd, uint8_t* buf, size_t len, uint64_t pos){
+    while (len > 0) {
+        ssize_t n = pread(fd, buf, len, static_cast<off_t>(pos));
+        if (n <= 0) return false;
+        buf += n;
+        pos += static_cast<uint64_t>(n);
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool PMAC::computeMAC(const std::string& filepath, std::array<uint8_t, 16>& mac, unsigned threads){
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+
+    const uint64_t size = static_cast<uint64_t>(st.st_size);
+    const size_t lastLen = size == 0 ? 0 : ((size - 1) % 16) + 1;
+    const uint64_t bodyBlocks = (size - lastLen) / 16;
+
+    // Each worker takes a contiguous range of body blocks, at least one chunk
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    const uint64_t chunkBlocks = kReadChunk / 16;
+    uint64_t maxWorkers = (bodyBlocks + chunkBlocks - 1) / chunkBlocks;
+    if (maxWorkers == 0) maxWorkers = 1;
+    if (threads > maxWorkers) threads = static_cast<unsigned>(maxWorkers);
+
+    std::vector<std::array<uint8_t, 16>> partial(threads);
+    std::vector<char> ok(threads, 1);
+    auto worker = [&](unsigned t){
+        uint64_t begin = bodyBlocks * t / threads;
+        uint64_t end = bodyBlocks * (t + 1) / threads;
+        uint8_t offset[16];
+        uint8_t sigma[16] = {0};
+        offsetAt(begin, offset);
+        std::unique_ptr<uint8_t[]> chunk(new uint8_t[kReadChunk]);
+        for (uint64_t b = begin; b < end; ) {
+            size_t n = static_cast<size_t>(std::min<uint64_t>(chunkBlocks, end - b));
+            if (!read_full(fd, chunk.get(), n * 16, b * 16)) {
+                ok[t] = 0;
+                return;
+            }
+            absorb(chunk.get(), n, b, offset, sigma);
+            b += n;
+        }
+        memcpy(partial[t].data(), sigma, 16);
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& th : pool) th.join();
+
+    uint8_t sigma[16] = {0};
+    for (unsigned t = 0; t < threads; ++t) {
+        if (!ok[t]) {
+            close(fd);
+            return false;
+        }
+        xor_into(sigma, partial[t].data());
+    }
+
+    uint8_t last[16];
+    bool lastOk = read_full(fd, last, lastLen, bodyBlocks * 16);
+    close(fd);
+    if (!lastOk) return false;
+    mac = finish(sigma, last, lastLen);
+    return true;
+}
+#endif
@@ -0,0 +1,141 @@
+/* Host command-line tool: CBC-MAC (or PMAC with --pmac) every file under a
+ * directory tree and write a manifest ("<hex mac>  <path>" per line).
+ * With --pmac and a single file instead of a directory, that one file is
+ * split across all threads.
+ *
+ * With --verify the second argument is a manifest cache (MAC, size, mtime):
+ * only files whose size or mtime changed are reread, mismatches are reported
+ * and the cache is rewritten. --full rereads every file anyway. A new
+ * cache is only started when none exists; an unreadable, corrupt or
+ * other-mode cache is left untouched and the tool exits with 2.
+ *
+ * Build (from Tercera/ejercicio2):
+ *   g++ -std=c++17 -O2 -pthread -Iinclude -Ilib/aes -I../lib/hexcodec \
+ *       tools/cbcmac_batch.cpp src/cbc_mac.cpp src/cbc_mac_batch.cpp src/pmac.cpp lib/aes/aes.c \
+ *       ../lib/hexcodec/hexcodec.cpp -o cbcmac_batch
+ *
+ * Usage:
+ *   cbcmac_batch [--pmac] <dir> <manifest> [threads] [key-hex]
+ *   cbcmac_batch [--pmac] --verify [--full] <dir> <cache> [threads] [key-hex]
+ */
+
+#include "CBCMAC.h"
+#include "CBCMACBatch.h"
+#include "PMAC.h"
+#include "hexcodec.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+
+static bool parseKey(const char* hex, uint8_t key[16]){
+    return strlen(hex) == 32 && hexcodec::decode(hex, 32, key);
+}
+
+static int runVerify(const uint8_t key[16], const char* root, const char* cachePath,
+                     unsigned threads, MACMode mode, bool full){
+    std::vector<MACEntry> cache;
+    CacheLoad loaded = loadManifestCache(cachePath, mode, cache);
+    if (loaded == CacheLoad::NotFound) {
+        fprintf(stderr, "no cache at %s, building a new one\n", cachePath);
+    } else if (loaded != CacheLoad::Ok) {
+        // Never replace a baseline we could not read: that would hide tampering
+        fprintf(stderr, "cache %s %s; left untouched\n", cachePath, cacheLoadMessage(loaded));
+        return 2;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto report = verifyMACBatch(key, root, cache, threads, mode, full);
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t counts[5] = {0, 0, 0, 0, 0};
+    for (const auto& r : report) {
+        ++counts[static_cast<int>(r.status)];
+        switch (r.status) {
+        case VerifyStatus::Modified: printf("MODIFIED  %s\n", r.path.c_str()); break;
+        case VerifyStatus::Missing:  printf("MISSING   %s\n", r.path.c_str()); break;
+        case VerifyStatus::Added:    printf("ADDED     %s\n", r.path.c_str()); break;
+        default: break;
+        }
+    }
+
+    if (!saveManifestCache(cache, mode, cachePath)) {
+        fprintf(stderr, "cannot write %s\n", cachePath);
+        return 1;
+    }
+    fprintf(stderr, "%zu unchanged, %zu verified, %zu modified, %zu missing, %zu added in %.3f s\n",
+            counts[0], counts[1], counts[2], counts[3], counts[4], secs);
+    return (counts[2] || counts[3]) ? 1 : 0;
+}
+
+int main(int argc, char** argv){
+    const char* prog = argv[0];
+    MACMode mode = MACMode::CBC;
+    bool verify = false;
+    bool full = false;
+    while (argc > 1 && strncmp(argv[1], "--", 2) == 0) {
+        if (strcmp(argv[1], "--pmac") == 0) mode = MACMode::PMAC;
+        else if (strcmp(argv[1], "--verify") == 0) verify = true;
+        else if (strcmp(argv[1], "--full") == 0) full = true;
+        else break;
+        --argc;
+        ++argv;
+    }
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s [--pmac] <dir> <manifest> [threads] [key-hex]\n", prog);
+        fprintf(stderr, "       %s [--pmac] --verify [--full] <dir> <cache> [threads] [key-hex]\n", prog);
+        return 2;
+    }
+
+    // Same example key as src/main.cpp unless one is given
+    uint8_t key[16] = {
+        0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,
+        0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x10
+    };
+    unsigned threads = argc > 3 ? static_cast<unsigned>(strtoul(argv[3], nullptr, 10)) : 0;
+    if (argc > 4 && !parseKey(argv[4], key)) {
+        fprintf(stderr, "invalid key: expected 32 hex characters\n");
+        return 2;
+    }
+
+    if (verify) return runVerify(key, argv[1], argv[2], threads, mode, full);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<MACEntry> entries;
+    if (mode == MACMode::PMAC && std::filesystem::is_regular_file(argv[1])) {
+        // One large file: let PMAC split it across the cores
+        MACEntry e;
+        std::error_code ec;
+        e.path = argv[1];
+        e.size = std::filesystem::file_size(e.path, ec);
+        e.mtime = 0;
+        e.mac.fill(0);
+        PMAC pmac(key);
+        e.ok = !ec && pmac.computeMAC(e.path, e.mac, threads);
+        entries.push_back(e);
+    } else {
+        auto files = listFilesRecursive(argv[1]);
+        entries = computeMACBatch(key, files, threads, mode);
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint64_t bytes = 0;
+    size_t failed = 0;
+    for (const auto& e : entries) {
+        bytes += e.size;
+        if (!e.ok) {
+            fprintf(stderr, "cannot read %s\n", e.path.c_str());
+            ++failed;
+        }
+    }
+
+    if (!saveManifestHex(entries, argv[2])) {
+        fprintf(stderr, "cannot write %s\n", argv[2]);
+        return 1;
+    }
+    fprintf(stderr, "%zu files, %.1f MiB in %.3f s\n",
+            entries.size() - failed, bytes / 1048576.0, secs);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "hexcodec.h"
+
+// Common streaming interface for hashes and MACs, so a single pass over the
+// input can feed several of them (see multiDigestFile in MultiDigest.h).
+class Digest {
+public:
+    virtual ~Digest() = default;
+
+    virtual const char* name() const = 0;
+    virtual size_t digestSize() const = 0;
+
+    virtual void update(const uint8_t* data, size_t length) = 0;
+    // Write digestSize() bytes to `out` and start a new message.
+    virtual void finish(uint8_t* out) = 0;
+    virtual void reset() = 0;
+
+    std::vector<uint8_t> result() {
+        std::vector<uint8_t> out(digestSize());
+        finish(out.data());
+        return out;
+    }
+
+    std::string hexResult() {
+        const std::vector<uint8_t> bytes = result();
+        return hexcodec::encode(bytes.data(), bytes.size());
+    }
+};
+
+// Adapter for MAC classes with the update()/final()/reset() shape of
+// CBCMAC and PMAC (Tercera/ejercicio2), without this project depending on
+// their headers:
+//
+//   MacDigest<CBCMAC> cbc("cbc-mac", key);
+template <class Mac>
+class MacDigest : public Digest {
+public:
+    template <class... Args>
+    explicit MacDigest(const char* name, Args&&... args)
+        : name_(name), mac_(std::forward<Args>(args)...) {}
+
+    Mac& mac() { return mac_; }
+
+    const char* name() const override { return name_; }
+    size_t digestSize() const override { return sizeof(decltype(std::declval<Mac&>().final())); }
+    void update(const uint8_t* data, size_t length) override { mac_.update(data, length); }
+    void finish(uint8_t* out) override {
+        const auto tag = mac_.final();
+        std::memcpy(out, tag.data(), tag.size());
+    }
+    void reset() override { mac_.reset(); }
+
+private:
+    const char* name_;
+    Mac mac_;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Digest.h"
+#include "MD5.h"
+#include "MD5Multi.h"
+
+// HMAC-MD5 (RFC 2104). The key pads are absorbed once in the constructor
+// and kept as MD5 midstates, so every message only costs its own blocks
+// plus one block for the outer hash.
+class HmacMD5 : public Digest {
+public:
+    HmacMD5(const uint8_t* key, size_t keyLength);
+    explicit HmacMD5(const std::string& key);
+
+    // Incremental interface; digest() finishes the message and starts a new one.
+    void update(const uint8_t* input, size_t length) override;
+    void update(const std::string& input);
+    std::array<uint8_t, 16> digest();
+    std::string hexdigest();
+    void reset() override;
+
+    // Digest interface
+    const char* name() const override { return "hmac-md5"; }
+    size_t digestSize() const override { return 16; }
+    void finish(uint8_t* out) override;
+
+    std::array<uint8_t, 16> compute(const uint8_t* data, size_t length) const;
+    std::string hash(const std::string& message) const;
+
+    // Many messages under the same key through the multi-lane MD5 core.
+    void computeBatch(const MD5Input* messages, size_t count, std::array<uint8_t, 16>* out) const;
+    std::vector<std::string> hashBatch(const std::vector<std::string>& messages) const;
+
+private:
+    MD5 inner_;       // running inner hash of the current message
+    MD5 innerPad_;    // midstate after (key ^ ipad)
+    MD5 outerPad_;    // midstate after (key ^ opad)
+
+    std::array<uint8_t, 16> finishInner(MD5& inner) const;
+};
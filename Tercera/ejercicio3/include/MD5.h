@@ -3,33 +3,62 @@
 #include <array>
 #include <cstdint>
 #include <string>
+#include <vector>
+
+#include "Digest.h"
 
 #ifdef ARDUINO
 #include <FS.h>
 #endif
 
-class MD5 {
+// Set to 0 to skip clearing the buffered message bytes in finalize().
+#ifndef MD5_SCRUB_ON_FINALIZE
+#define MD5_SCRUB_ON_FINALIZE 1
+#endif
+
+class MD5 : public Digest {
 public:
     MD5();
 
-    void update(const uint8_t* input, size_t length);
+    void update(const uint8_t* input, size_t length) override;
     void update(const std::string& input);
     void finalize();
     std::array<uint8_t, 16> digest();
     std::string hexdigest();
-    void reset();
+    void reset() override;
+
+    // Digest interface; finish() writes the digest and resets.
+    const char* name() const override { return "md5"; }
+    size_t digestSize() const override { return 16; }
+    void finish(uint8_t* out) override;
+
+    // Midstate checkpoint: a compact versioned blob with the chaining state,
+    // the byte count and the pending partial block (at most 93 bytes).
+    // Only an unfinalized hash can be exported; an invalid blob is rejected
+    // and leaves the object untouched.
+    std::vector<uint8_t> exportState() const;
+    bool importState(const std::vector<uint8_t>& blob);
+    uint64_t bytesProcessed() const { return bitCount_ / 8; }
 
     static std::string hash(const std::string& input);
     static std::string hash(const uint8_t* data, size_t length);
 
+    // Hash an append-only file resuming from `checkpoint` (empty = from the
+    // start). Only the bytes after the checkpoint offset are read; on return
+    // `checkpoint` holds the midstate at the current end of file. If the file
+    // is now shorter than the checkpoint it is rehashed from scratch.
 #ifdef ARDUINO
     static std::string hashFile(fs::FS& fs, const char* path);
     static std::string hashFile(const char* path);
+    static std::string hashFileIncremental(fs::FS& fs, const char* path, std::vector<uint8_t>& checkpoint);
 #else
     static std::string hashFile(const std::string& path);
+    static std::string hashFileIncremental(const std::string& path, std::vector<uint8_t>& checkpoint);
 #endif
 
 private:
+    friend class MD5Multi;  // reads the midstate to start lanes from a prefix
+
     bool finalized_;
     uint32_t state_[4];
     uint64_t bitCount_;
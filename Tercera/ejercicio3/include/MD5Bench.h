@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+
+// Throughput of the MD5 compression core, in MB/s, on `bytes` of data
+// (rounded down to whole blocks), for the tuned MD5 and for the
+// pre-optimization reference in MD5Reference.h. Runs on host and board.
+struct MD5BenchResult {
+    double referenceMBs;
+    double tunedMBs;
+    bool sameDigest;
+};
+
+MD5BenchResult runMD5Benchmark(size_t bytes, unsigned repetitions);
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifdef ARDUINO
+#include <FS.h>
+#else
+#include <unordered_map>
+#endif
+
+// Content-defined chunking with MD5 fingerprints. Boundaries are found with
+// a gear rolling hash over the last 64 bytes (FastCDC-style: a stricter mask
+// before the average size, a looser one after it, hard minimum and maximum),
+// so an insertion only changes the chunks around it and near-identical
+// files share most of their fingerprints.
+//
+// A cut depends only on the 64 bytes before it, which lets the host scan a
+// buffer on several threads and still produce exactly the serial chunks.
+
+using MD5Bytes = std::array<uint8_t, 16>;
+
+struct MD5Chunk {
+    uint64_t offset;
+    uint32_t length;
+    MD5Bytes digest;
+};
+
+class MD5Chunker {
+public:
+    static constexpr uint32_t kDefaultMinSize = 2 * 1024;
+    static constexpr uint32_t kDefaultAvgSize = 8 * 1024;
+    static constexpr uint32_t kDefaultMaxSize = 64 * 1024;
+
+    // Sizes are adjusted to 64 <= min < avg <= max; avg is rounded down to
+    // a power of two.
+    explicit MD5Chunker(uint32_t minSize = kDefaultMinSize, uint32_t avgSize = kDefaultAvgSize,
+                        uint32_t maxSize = kDefaultMaxSize);
+
+    uint32_t minSize() const { return minSize_; }
+    uint32_t avgSize() const { return avgSize_; }
+    uint32_t maxSize() const { return maxSize_; }
+
+    // Length of the first chunk of data[0, length), taking `length` as the
+    // end of the input.
+    size_t cut(const uint8_t* data, size_t length) const;
+
+    // End offsets of every chunk of the buffer. `threads` = 0 uses hardware
+    // concurrency; ignored on the board.
+    std::vector<size_t> cutPoints(const uint8_t* data, size_t length, unsigned threads = 0) const;
+
+    // Chunks with their MD5 (hashed through MD5Multi lanes).
+    std::vector<MD5Chunk> chunks(const uint8_t* data, size_t length, unsigned threads = 0) const;
+
+    // Stream a file; false on read errors. An empty file has no chunks.
+#ifdef ARDUINO
+    bool chunkFile(fs::FS& fs, const char* path, std::vector<MD5Chunk>& out) const;
+#else
+    bool chunkFile(const std::string& path, std::vector<MD5Chunk>& out, unsigned threads = 0) const;
+#endif
+
+private:
+    uint32_t minSize_;
+    uint32_t avgSize_;
+    uint32_t maxSize_;
+    uint64_t maskStrict_;  // before avgSize
+    uint64_t maskLoose_;   // from avgSize on
+
+    size_t cutPoints(const uint8_t* data, size_t length, bool final, unsigned threads,
+                     std::vector<size_t>& ends) const;
+    void fingerprint(const uint8_t* data, const std::vector<size_t>& ends, size_t count,
+                     uint64_t baseOffset, unsigned threads, std::vector<MD5Chunk>& out) const;
+};
+
+#ifndef ARDUINO
+struct MD5ChunkLocation {
+    std::string path;
+    uint64_t offset;
+    uint32_t length;
+};
+
+// Fingerprint -> first place the chunk was seen, persisted as text:
+//   # md5-chunks v1
+//   <hex digest> <offset> <length>  <path>
+// Only meaningful for chunks produced with the same MD5Chunker sizes.
+class MD5ChunkIndex {
+public:
+    // Record the chunks of `path`; returns how many were not indexed yet.
+    size_t add(const std::string& path, const std::vector<MD5Chunk>& chunks);
+    const MD5ChunkLocation* find(const MD5Bytes& digest) const;
+
+    size_t size() const { return chunks_.size(); }
+    // Bytes needed to store every distinct chunk once.
+    uint64_t uniqueBytes() const { return uniqueBytes_; }
+
+    bool save(const std::string& path) const;
+    // Replaces the current contents; false (and empty) on a bad file.
+    bool load(const std::string& path);
+
+private:
+    struct DigestHash {
+        size_t operator()(const MD5Bytes& digest) const;
+    };
+
+    std::unordered_map<MD5Bytes, MD5ChunkLocation, DigestHash> chunks_;
+    uint64_t uniqueBytes_ = 0;
+};
+#endif
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Compile-time MD5 for literals (C++17). Produces the same bytes as
+// MD5::digest(), but the compiler evaluates it, so digests of fixed strings
+// cost nothing at startup and can key constexpr tables:
+//
+//   constexpr auto kDigest = md5c::digest("abc");
+//   static_assert(md5c::equal(kDigest, md5c::fromHex("900150983cd24fb0d6963f7d28e17f72")));
+//
+// Intended for short literals; long inputs may hit the compiler's
+// constant-evaluation limits.
+
+namespace md5c {
+
+using Digest = std::array<uint8_t, 16>;
+
+namespace detail {
+
+constexpr uint32_t kK[64] = {
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+    0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+    0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+    0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+    0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+    0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391,
+};
+
+constexpr uint32_t kShift[64] = {
+    7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+    5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20,
+    4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+    6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21,
+};
+
+// Byte i of the padded message: data, 0x80, zeros, bit length (LE64).
+constexpr uint8_t paddedByte(const char* data, size_t length, size_t paddedLength, size_t i) {
+    if (i < length) {
+        return static_cast<uint8_t>(data[i]);
+    }
+    if (i == length) {
+        return 0x80;
+    }
+    if (i >= paddedLength - 8) {
+        const uint64_t bits = static_cast<uint64_t>(length) * 8ULL;
+        return static_cast<uint8_t>(bits >> (8 * (i - (paddedLength - 8))));
+    }
+    return 0;
+}
+
+constexpr void transform(uint32_t (&state)[4], const char* data, size_t length,
+                         size_t paddedLength, size_t offset) {
+    uint32_t x[16] = {};
+    for (size_t w = 0; w < 16; ++w) {
+        for (size_t b = 0; b < 4; ++b) {
+            x[w] |= static_cast<uint32_t>(paddedByte(data, length, paddedLength, offset + 4 * w + b)) << (8 * b);
+        }
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    for (size_t i = 0; i < 64; ++i) {
+        uint32_t f = 0;
+        size_t g = 0;
+        if (i < 16) {
+            f = d ^ (b & (c ^ d));
+            g = i;
+        } else if (i < 32) {
+            f = c ^ (d & (b ^ c));
+            g = (5 * i + 1) & 15;
+        } else if (i < 48) {
+            f = b ^ c ^ d;
+            g = (3 * i + 5) & 15;
+        } else {
+            f = c ^ (b | ~d);
+            g = (7 * i) & 15;
+        }
+        f = f + a + kK[i] + x[g];
+        a = d;
+        d = c;
+        c = b;
+        b = b + ((f << kShift[i]) | (f >> (32 - kShift[i])));
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+}
+
+// Not constexpr on purpose: reaching it makes a compile-time fromHex() of a
+// bad string fail to compile (no exceptions needed on the board).
+inline uint8_t invalidHexDigit() {
+    return 0;
+}
+
+constexpr uint8_t hexNibble(char c) {
+    return (c >= '0' && c <= '9') ? static_cast<uint8_t>(c - '0')
+         : (c >= 'a' && c <= 'f') ? static_cast<uint8_t>(c - 'a' + 10)
+         : (c >= 'A' && c <= 'F') ? static_cast<uint8_t>(c - 'A' + 10)
+         : invalidHexDigit();
+}
+
+} // namespace detail
+
+constexpr Digest digest(const char* data, size_t length) {
+    uint32_t state[4] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
+    const size_t paddedLength = ((length + 8) / 64 + 1) * 64;
+    for (size_t offset = 0; offset < paddedLength; offset += 64) {
+        detail::transform(state, data, length, paddedLength, offset);
+    }
+    Digest out{};
+    for (size_t i = 0; i < 16; ++i) {
+        out[i] = static_cast<uint8_t>(state[i / 4] >> (8 * (i % 4)));
+    }
+    return out;
+}
+
+// Digest of a string literal, without its terminating '\0'.
+template <size_t N>
+constexpr Digest digest(const char (&literal)[N]) {
+    return digest(literal, N - 1);
+}
+
+// Parse a 32-character hex digest (as printed by MD5::hexdigest()).
+template <size_t N>
+constexpr Digest fromHex(const char (&hex)[N]) {
+    static_assert(N == 33, "md5c::fromHex expects 32 hex characters");
+    Digest out{};
+    for (size_t i = 0; i < 16; ++i) {
+        out[i] = static_cast<uint8_t>((detail::hexNibble(hex[2 * i]) << 4) | detail::hexNibble(hex[2 * i + 1]));
+    }
+    return out;
+}
+
+// std::array::operator== is only constexpr from C++20.
+constexpr bool equal(const Digest& a, const Digest& b) {
+    for (size_t i = 0; i < 16; ++i) {
+        if (a[i] != b[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace md5c
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class MD5;
+
+// Multi-buffer MD5: hashes several independent messages at once, one message
+// per SIMD lane (4 lanes with SSE2/NEON, 8 with AVX2, 16 with AVX-512).
+// A single message is still hashed block after block; the speedup comes from
+// batches of many small inputs. Digests are identical to MD5::digest().
+
+struct MD5Input {
+    const uint8_t* data;
+    size_t length;
+};
+
+class MD5Multi {
+public:
+    // Number of lanes used on this machine (1 when no SIMD path is built).
+    static size_t lanes();
+
+    // out must have room for count digests; out[i] is the digest of inputs[i].
+    static void digestBatch(const MD5Input* inputs, size_t count, std::array<uint8_t, 16>* out);
+
+    static std::vector<std::array<uint8_t, 16>> digestBatch(const std::vector<MD5Input>& inputs);
+
+    // Like digestBatch, but every input continues from the midstate `prefix`
+    // (e.g. an HMAC key pad already absorbed), i.e. out[i] is the digest of
+    // prefix data || inputs[i]. `prefix` itself is not modified.
+    static void digestBatch(const MD5& prefix, const MD5Input* inputs, size_t count,
+                            std::array<uint8_t, 16>* out);
+
+    // Same strings as MD5::hash() for every input.
+    static std::vector<std::string> hashBatch(const std::vector<std::string>& inputs);
+};
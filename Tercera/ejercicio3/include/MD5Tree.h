@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Merkle-tree hashing built on MD5. The input is split into fixed-size
+// leaves that are hashed independently (in parallel on the host) and the
+// root is derived from the leaf digests:
+//
+//   leaf = MD5(0x00 || leaf bytes)
+//   node = MD5(0x01 || left || right)   (an odd node is carried up as is)
+//
+// The root is NOT an MD5 of the data and never equals MD5::hash(); it is
+// returned as MD5TreeDigest and printed with an "md5tree-" prefix.
+
+using MD5Bytes = std::array<uint8_t, 16>;
+
+struct MD5TreeDigest {
+    MD5Bytes root;
+    uint64_t length;
+    uint32_t leafSize;
+
+    // "md5tree-<leafSize>:<hex root>"
+    std::string hexdigest() const;
+};
+
+class MD5Tree {
+public:
+    static constexpr uint32_t kDefaultLeafSize = 1024 * 1024;
+
+    explicit MD5Tree(uint32_t leafSize = kDefaultLeafSize);
+
+    uint32_t leafSize() const { return leafSize_; }
+    uint64_t leafCount(uint64_t length) const;
+
+    static MD5Bytes hashLeaf(const uint8_t* data, size_t length);
+    static MD5Bytes rootFromLeaves(const std::vector<MD5Bytes>& leaves);
+
+    // `threads` = 0 uses hardware concurrency; ignored on the board.
+    std::vector<MD5Bytes> leafDigests(const uint8_t* data, size_t length, unsigned threads = 0) const;
+    MD5TreeDigest hash(const uint8_t* data, size_t length, unsigned threads = 0) const;
+
+#ifndef ARDUINO
+    // Empty vector / zero root on read errors.
+    std::vector<MD5Bytes> leafDigests(const std::string& path, unsigned threads = 0) const;
+    MD5TreeDigest hashFile(const std::string& path, unsigned threads = 0) const;
+
+    // Rehash leaves [first, first + count) of the file into `leaves` (a leaf
+    // list from leafDigests, resized if the file changed length); the new
+    // root is rootFromLeaves(leaves). False on read errors.
+    bool rehashLeafRange(const std::string& path, std::vector<MD5Bytes>& leaves,
+                         uint64_t first, uint64_t count, unsigned threads = 0) const;
+    // True if leaves [first, first + count) of the file match `leaves`.
+    bool verifyLeafRange(const std::string& path, const std::vector<MD5Bytes>& leaves,
+                         uint64_t first, uint64_t count, unsigned threads = 0) const;
+#endif
+
+private:
+    uint32_t leafSize_;
+};
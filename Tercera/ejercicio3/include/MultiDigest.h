@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Digest.h"
+
+#ifdef ARDUINO
+#include <FS.h>
+#endif
+
+// Feed a whole file to several digests reading it only once. Each chunk is
+// handed to every digest before it is recycled; on the host every digest
+// runs on its own thread, a few chunks behind the reader, so the data is
+// still in cache when the slower ones get to it. On the board the digests
+// are updated one after another from the same buffer.
+//
+// The digests are not reset first and not finished: call finish()/result()
+// on each afterwards. Returns false if the file cannot be opened or read.
+#ifdef ARDUINO
+bool multiDigestFile(fs::FS& fs, const char* path, Digest* const* digests, size_t count);
+bool multiDigestFile(fs::FS& fs, const char* path, const std::vector<Digest*>& digests);
+#else
+bool multiDigestFile(const std::string& path, Digest* const* digests, size_t count);
+bool multiDigestFile(const std::string& path, const std::vector<Digest*>& digests);
+#endif
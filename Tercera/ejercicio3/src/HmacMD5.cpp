@@ -0,0 +1,111 @@
+#include "HmacMD5.h"
+
+#include "hexcodec.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+constexpr size_t kBlockSize = 64;
+
+}
+
+HmacMD5::HmacMD5(const uint8_t* key, size_t keyLength) {
+    uint8_t block[kBlockSize] = {0};
+    if (keyLength > kBlockSize) {
+        MD5 md5;
+        md5.update(key, keyLength);
+        auto hashed = md5.digest();
+        std::memcpy(block, hashed.data(), hashed.size());
+    } else if (keyLength > 0) {
+        std::memcpy(block, key, keyLength);
+    }
+
+    uint8_t pad[kBlockSize];
+    for (size_t i = 0; i < kBlockSize; ++i) {
+        pad[i] = block[i] ^ 0x36;
+    }
+    innerPad_.update(pad, kBlockSize);
+    for (size_t i = 0; i < kBlockSize; ++i) {
+        pad[i] = block[i] ^ 0x5c;
+    }
+    outerPad_.update(pad, kBlockSize);
+
+    std::fill(std::begin(block), std::end(block), 0);
+    std::fill(std::begin(pad), std::end(pad), 0);
+    inner_ = innerPad_;
+}
+
+HmacMD5::HmacMD5(const std::string& key)
+    : HmacMD5(reinterpret_cast<const uint8_t*>(key.data()), key.size()) {}
+
+void HmacMD5::reset() {
+    inner_ = innerPad_;
+}
+
+void HmacMD5::update(const uint8_t* input, size_t length) {
+    inner_.update(input, length);
+}
+
+void HmacMD5::update(const std::string& input) {
+    inner_.update(input);
+}
+
+std::array<uint8_t, 16> HmacMD5::finishInner(MD5& inner) const {
+    auto innerDigest = inner.digest();
+    MD5 outer = outerPad_;
+    outer.update(innerDigest.data(), innerDigest.size());
+    return outer.digest();
+}
+
+std::array<uint8_t, 16> HmacMD5::digest() {
+    auto mac = finishInner(inner_);
+    reset();
+    return mac;
+}
+
+std::string HmacMD5::hexdigest() {
+    return hexcodec::encode(digest());
+}
+
+void HmacMD5::finish(uint8_t* out) {
+    const auto mac = digest();
+    std::memcpy(out, mac.data(), mac.size());
+}
+
+std::array<uint8_t, 16> HmacMD5::compute(const uint8_t* data, size_t length) const {
+    MD5 inner = innerPad_;
+    inner.update(data, length);
+    return finishInner(inner);
+}
+
+std::string HmacMD5::hash(const std::string& message) const {
+    return hexcodec::encode(compute(reinterpret_cast<const uint8_t*>(message.data()), message.size()));
+}
+
+void HmacMD5::computeBatch(const MD5Input* messages, size_t count, std::array<uint8_t, 16>* out) const {
+    // Inner hashes of all messages, then all outer hashes, each as one batch
+    std::vector<std::array<uint8_t, 16>> inner(count);
+    MD5Multi::digestBatch(innerPad_, messages, count, inner.data());
+
+    std::vector<MD5Input> innerInputs(count);
+    for (size_t i = 0; i < count; ++i) {
+        innerInputs[i] = {inner[i].data(), inner[i].size()};
+    }
+    MD5Multi::digestBatch(outerPad_, innerInputs.data(), count, out);
+}
+
+std::vector<std::string> HmacMD5::hashBatch(const std::vector<std::string>& messages) const {
+    std::vector<MD5Input> views(messages.size());
+    for (size_t i = 0; i < messages.size(); ++i) {
+        views[i] = {reinterpret_cast<const uint8_t*>(messages[i].data()), messages[i].size()};
+    }
+    std::vector<std::array<uint8_t, 16>> macs(messages.size());
+    computeBatch(views.data(), views.size(), macs.data());
+
+    std::vector<std::string> output(macs.size());
+    for (size_t i = 0; i < macs.size(); ++i) {
+        output[i] = hexcodec::encode(macs[i]);
+    }
+    return output;
+}
@@ -1,12 +1,26 @@
 #include "MD5.h"
 
+#include "hexcodec.h"
+
 #include <algorithm>
 #include <array>
 #include <cstring>
 #include <iterator>
 
+#include <vector>
+
 #ifndef ARDUINO
+#include <condition_variable>
 #include <fstream>
+#include <mutex>
+#include <thread>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MD5_HAVE_MMAP 1
+#endif
 #else
 #include <Arduino.h>
 #include <FS.h>
@@ -26,45 +40,134 @@ constexpr std::array<uint8_t, 64> PADDING = [] {
     return pad;
 }();
 
-inline uint32_t F(uint32_t x, uint32_t y, uint32_t z) {
-    return (x & y) | (~x & z);
+#ifndef ARDUINO
+// Buffered fallback: two large buffers, a reader thread fills one while the
+// caller hashes the other. Sizes are multiples of 64 so every buffer except
+// the last is consumed as whole blocks straight from memory.
+constexpr size_t kReadAheadChunk = 1 << 20;
+
+class ReadAhead {
+public:
+    explicit ReadAhead(std::ifstream& file) : file_(file) {
+        for (auto& buf : buffers_) {
+            buf.resize(kReadAheadChunk);
+        }
+        reader_ = std::thread([this] { run(); });
+    }
+
+    ~ReadAhead() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        reader_.join();
+    }
+
+    // Next filled buffer; size 0 at end of file.
+    const uint8_t* acquire(size_t& size) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return ready_[current_]; });
+        size = filled_[current_];
+        return buffers_[current_].data();
+    }
+
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ready_[current_] = false;
+        }
+        current_ ^= 1;
+        cv_.notify_all();
+    }
+
+private:
+    std::ifstream& file_;
+    std::vector<uint8_t> buffers_[2];
+    size_t filled_[2] = {0, 0};
+    bool ready_[2] = {false, false};
+    bool stop_ = false;
+    size_t current_ = 0;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread reader_;
+
+    void run() {
+        for (size_t slot = 0;; slot ^= 1) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [&] { return !ready_[slot] || stop_; });
+                if (stop_) {
+                    return;
+                }
+            }
+            size_t count = 0;
+            if (file_.good()) {
+                file_.read(reinterpret_cast<char*>(buffers_[slot].data()), kReadAheadChunk);
+                count = static_cast<size_t>(file_.gcount());
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                filled_[slot] = count;
+                ready_[slot] = true;
+            }
+            cv_.notify_all();
+            if (count == 0) {
+                return;
+            }
+        }
+    }
+};
+#endif
+
+// The step helpers must be inlined into transform() even at -Os (the
+// PlatformIO default) so every shift and constant is an immediate.
+#if defined(__GNUC__)
+#define MD5_INLINE inline __attribute__((always_inline))
+#else
+#define MD5_INLINE inline
+#endif
+
+// F and G in their one-operation-shorter select forms.
+MD5_INLINE uint32_t F(uint32_t x, uint32_t y, uint32_t z) {
+    return z ^ (x & (y ^ z));
 }
 
-inline uint32_t G(uint32_t x, uint32_t y, uint32_t z) {
-    return (x & z) | (y & ~z);
+MD5_INLINE uint32_t G(uint32_t x, uint32_t y, uint32_t z) {
+    return y ^ (z & (x ^ y));
 }
 
-inline uint32_t H(uint32_t x, uint32_t y, uint32_t z) {
+MD5_INLINE uint32_t H(uint32_t x, uint32_t y, uint32_t z) {
     return x ^ y ^ z;
 }
 
-inline uint32_t I(uint32_t x, uint32_t y, uint32_t z) {
+MD5_INLINE uint32_t I(uint32_t x, uint32_t y, uint32_t z) {
     return y ^ (x | ~z);
 }
 
-inline uint32_t rotateLeft(uint32_t value, uint32_t bits) {
+MD5_INLINE uint32_t rotateLeft(uint32_t value, uint32_t bits) {
     return (value << bits) | (value >> (32U - bits));
 }
 
-inline void FF(uint32_t& a, uint32_t b, uint32_t c, uint32_t d, uint32_t x, uint32_t s, uint32_t ac) {
+MD5_INLINE void FF(uint32_t& a, uint32_t b, uint32_t c, uint32_t d, uint32_t x, uint32_t s, uint32_t ac) {
     a += F(b, c, d) + x + ac;
     a = rotateLeft(a, s);
     a += b;
 }
 
-inline void GG(uint32_t& a, uint32_t b, uint32_t c, uint32_t d, uint32_t x, uint32_t s, uint32_t ac) {
+MD5_INLINE void GG(uint32_t& a, uint32_t b, uint32_t c, uint32_t d, uint32_t x, uint32_t s, uint32_t ac) {
     a += G(b, c, d) + x + ac;
     a = rotateLeft(a, s);
     a += b;
 }
 
-inline void HH(uint32_t& a, uint32_t b, uint32_t c, uint32_t d, uint32_t x, uint32_t s, uint32_t ac) {
+MD5_INLINE void HH(uint32_t& a, uint32_t b, uint32_t c, uint32_t d, uint32_t x, uint32_t s, uint32_t ac) {
     a += H(b, c, d) + x + ac;
     a = rotateLeft(a, s);
     a += b;
 }
 
-inline void II(uint32_t& a, uint32_t b, uint32_t c, uint32_t d, uint32_t x, uint32_t s, uint32_t ac) {
+MD5_INLINE void II(uint32_t& a, uint32_t b, uint32_t c, uint32_t d, uint32_t x, uint32_t s, uint32_t ac) {
     a += I(b, c, d) + x + ac;
     a = rotateLeft(a, s);
     a += b;
@@ -103,10 +206,14 @@ void MD5::update(const uint8_t* input, size_t length) {
     size_t i = 0;
 
     if (length >= partLen) {
-        std::memcpy(&buffer_[index], input, partLen);
-        transform(buffer_);
+        // With an empty buffer whole blocks are hashed in place, no copy.
+        if (index != 0) {
+            std::memcpy(&buffer_[index], input, partLen);
+            transform(buffer_);
+            i = partLen;
+        }
 
-        for (i = partLen; i + 63 < length; i += 64) {
+        for (; i + 63 < length; i += 64) {
             transform(&input[i]);
         }
 
@@ -138,9 +245,61 @@ void MD5::finalize() {
 
     encode(state_, digest_.data(), 16);
 
+#if MD5_SCRUB_ON_FINALIZE
+    // Clear buffered message bytes once per message instead of per block.
+    volatile uint8_t* scrub = buffer_;
+    for (size_t i = 0; i < sizeof(buffer_); ++i) {
+        scrub[i] = 0;
+    }
+#endif
+
     finalized_ = true;
 }
 
+namespace {
+constexpr uint8_t kStateMagic[4] = {'M', 'D', '5', 'S'};
+constexpr uint8_t kStateVersion = 1;
+constexpr size_t kStateHeader = 4 + 1 + 8 + 16 + 1;
+}
+
+std::vector<uint8_t> MD5::exportState() const {
+    if (finalized_) {
+        return {};
+    }
+    // magic | version | byte count (LE64) | state (4 x LE32) | pending length | pending bytes
+    const uint64_t bytes = bitCount_ / 8;
+    const size_t pending = static_cast<size_t>(bytes % 64);
+    std::vector<uint8_t> blob(kStateHeader + pending);
+    std::memcpy(blob.data(), kStateMagic, 4);
+    blob[4] = kStateVersion;
+    encode(bytes, &blob[5]);
+    encode(state_, &blob[13], 16);
+    blob[29] = static_cast<uint8_t>(pending);
+    std::memcpy(&blob[30], buffer_, pending);
+    return blob;
+}
+
+bool MD5::importState(const std::vector<uint8_t>& blob) {
+    if (blob.size() < kStateHeader || std::memcmp(blob.data(), kStateMagic, 4) != 0 ||
+        blob[4] != kStateVersion) {
+        return false;
+    }
+    uint64_t bytes = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        bytes |= static_cast<uint64_t>(blob[5 + i]) << (8 * i);
+    }
+    const size_t pending = blob[29];
+    if (pending != bytes % 64 || blob.size() != kStateHeader + pending || bytes > (UINT64_MAX >> 3)) {
+        return false;
+    }
+
+    reset();
+    decode(&blob[13], state_, 16);
+    bitCount_ = bytes * 8ULL;
+    std::memcpy(buffer_, &blob[30], pending);
+    return true;
+}
+
 std::array<uint8_t, 16> MD5::digest() {
     if (!finalized_) {
         finalize();
@@ -149,17 +308,13 @@ std::array<uint8_t, 16> MD5::digest() {
 }
 
 std::string MD5::hexdigest() {
-    auto bytes = digest();
-    static const char* digits = "0123456789abcdef";
-    std::string output;
-    output.reserve(32);
-
-    for (uint8_t byte : bytes) {
-        output.push_back(digits[(byte >> 4) & 0x0F]);
-        output.push_back(digits[byte & 0x0F]);
-    }
+    return hexcodec::encode(digest());
+}
 
-    return output;
+void MD5::finish(uint8_t* out) {
+    const auto bytes = digest();
+    std::memcpy(out, bytes.data(), bytes.size());
+    reset();
 }
 
 std::string MD5::hash(const std::string& input) {
@@ -185,8 +340,40 @@ std::string MD5::hashFile(fs::FS& fs, const char* path) {
         return {};
     }
 
+    // 4 KiB (64 MD5 blocks) per read keeps the per-call overhead low.
+    MD5 md5;
+    std::vector<uint8_t> block(4096);
+    while (file.available()) {
+        size_t readBytes = file.read(block.data(), block.size());
+        if (readBytes == 0) {
+            break;
+        }
+        md5.update(block.data(), readBytes);
+    }
+    file.close();
+    return md5.hexdigest();
+}
+
+std::string MD5::hashFileIncremental(fs::FS& fs, const char* path, std::vector<uint8_t>& checkpoint) {
+    if (path == nullptr) {
+        return {};
+    }
+
+    File file = fs.open(path, "r");
+    if (!file) {
+        return {};
+    }
+
     MD5 md5;
-    std::array<uint8_t, 512> block{};
+    if (!md5.importState(checkpoint) || md5.bytesProcessed() > file.size()) {
+        md5.reset();
+    }
+    if (!file.seek(md5.bytesProcessed())) {
+        file.close();
+        return {};
+    }
+
+    std::vector<uint8_t> block(4096);
     while (file.available()) {
         size_t readBytes = file.read(block.data(), block.size());
         if (readBytes == 0) {
@@ -195,6 +382,8 @@ std::string MD5::hashFile(fs::FS& fs, const char* path) {
         md5.update(block.data(), readBytes);
     }
     file.close();
+
+    checkpoint = md5.exportState();
     return md5.hexdigest();
 }
 
@@ -207,21 +396,78 @@ std::string MD5::hashFile(const char* path) {
 }
 #else
 std::string MD5::hashFile(const std::string& path) {
+#ifdef MD5_HAVE_MMAP
+    // Map the whole file and hash it in place; falls back to buffered reads
+    // for anything that cannot be mapped (pipes, special files, ...).
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            size_t size = static_cast<size_t>(st.st_size);
+            void* map = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map != MAP_FAILED) {
+                ::madvise(map, size, MADV_SEQUENTIAL);
+                MD5 md5;
+                md5.update(static_cast<const uint8_t*>(map), size);
+                ::munmap(map, size);
+                ::close(fd);
+                return md5.hexdigest();
+            }
+        }
+        ::close(fd);
+    }
+#endif
+
     std::ifstream file(path, std::ios::binary);
     if (!file) {
         return {};
     }
 
     MD5 md5;
-    std::array<char, 1024> block{};
-    while (file.good()) {
-        file.read(block.data(), block.size());
-        std::streamsize count = file.gcount();
-        if (count > 0) {
-            md5.update(reinterpret_cast<const uint8_t*>(block.data()), static_cast<size_t>(count));
+    ReadAhead reader(file);
+    while (true) {
+        size_t count = 0;
+        const uint8_t* data = reader.acquire(count);
+        if (count == 0) {
+            break;
+        }
+        md5.update(data, count);
+        reader.release();
+    }
+
+    return md5.hexdigest();
+}
+
+std::string MD5::hashFileIncremental(const std::string& path, std::vector<uint8_t>& checkpoint) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return {};
+    }
+    const uint64_t size = static_cast<uint64_t>(file.tellg());
+
+    MD5 md5;
+    if (!md5.importState(checkpoint) || md5.bytesProcessed() > size) {
+        md5.reset();
+    }
+    file.seekg(static_cast<std::streamoff>(md5.bytesProcessed()));
+    if (!file) {
+        return {};
+    }
+
+    {
+        ReadAhead reader(file);
+        while (true) {
+            size_t count = 0;
+            const uint8_t* data = reader.acquire(count);
+            if (count == 0) {
+                break;
+            }
+            md5.update(data, count);
+            reader.release();
         }
     }
 
+    checkpoint = md5.exportState();
     return md5.hexdigest();
 }
 #endif
@@ -311,8 +557,6 @@ void MD5::transform(const uint8_t block[64]) {
     state_[1] += b;
     state_[2] += c;
     state_[3] += d;
-
-    std::fill(std::begin(x), std::end(x), 0);
 }
 
 void MD5::encode(const uint32_t* input, uint8_t* output, size_t length) const {
@@ -331,10 +575,15 @@ void MD5::encode(uint64_t input, uint8_t output[8]) const {
 }
 
 void MD5::decode(const uint8_t* input, uint32_t* output, size_t length) const {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    // Little-endian hosts (x86-64, Xtensa): the words are already in order.
+    std::memcpy(output, input, length);
+#else
     for (size_t i = 0, j = 0; j < length; ++i, j += 4) {
         output[i] = static_cast<uint32_t>(input[j]) |
                     (static_cast<uint32_t>(input[j + 1]) << 8) |
                     (static_cast<uint32_t>(input[j + 2]) << 16) |
                     (static_cast<uint32_t>(input[j + 3]) << 24);
     }
+#endif
 }
@@ -0,0 +1,69 @@
+#include "MD5Bench.h"
+
+#include "MD5.h"
+#include "MD5Reference.h"
+
+#include <vector>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <chrono>
+#endif
+
+namespace {
+double nowSeconds() {
+#ifdef ARDUINO
+    return micros() / 1e6;
+#else
+    using Clock = std::chrono::steady_clock;
+    return std::chrono::duration<double>(Clock::now().time_since_epoch()).count();
+#endif
+}
+}
+
+MD5BenchResult runMD5Benchmark(size_t bytes, unsigned repetitions) {
+    bytes -= bytes % 64;
+    std::vector<uint8_t> data(bytes);
+    for (size_t i = 0; i < bytes; ++i) {
+        data[i] = static_cast<uint8_t>(i * 131 + 7);
+    }
+
+    // Reference: raw compression of every block from the initial state
+    uint32_t refState[4] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
+    double start = nowSeconds();
+    for (unsigned r = 0; r < repetitions; ++r) {
+        for (size_t i = 0; i < bytes; i += 64) {
+            md5_reference::transform(refState, &data[i]);
+        }
+    }
+    double refSeconds = nowSeconds() - start;
+
+    // Tuned: MD5::update over whole blocks hashes them in place
+    MD5 md5;
+    start = nowSeconds();
+    for (unsigned r = 0; r < repetitions; ++r) {
+        md5.update(data.data(), bytes);
+    }
+    double tunedSeconds = nowSeconds() - start;
+
+    // Both paths must give the same digest: pad the reference by hand
+    uint8_t pad[64] = {0x80};
+    uint64_t bits = static_cast<uint64_t>(bytes) * repetitions * 8ULL;
+    for (size_t i = 0; i < 8; ++i) {
+        pad[56 + i] = static_cast<uint8_t>(bits >> (8 * i));
+    }
+    md5_reference::transform(refState, pad);
+    auto tuned = md5.digest();
+    bool same = true;
+    for (size_t i = 0; i < 16; ++i) {
+        same = same && tuned[i] == static_cast<uint8_t>(refState[i / 4] >> (8 * (i % 4)));
+    }
+
+    const double mb = static_cast<double>(bytes) * repetitions / 1e6;
+    MD5BenchResult result;
+    result.referenceMBs = refSeconds > 0 ? mb / refSeconds : 0;
+    result.tunedMBs = tunedSeconds > 0 ? mb / tunedSeconds : 0;
+    result.sameDigest = same;
+    return result;
+}
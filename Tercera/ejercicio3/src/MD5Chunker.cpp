@@ -0,0 +1,394 @@
+#include "MD5Chunker.h"
+
+#include "MD5Multi.h"
+#include "hexcodec.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#endif
+
+namespace {
+constexpr size_t kWindow = 64;  // bytes that influence the gear hash
+
+struct GearTable {
+    uint64_t v[256];
+};
+
+// Fixed pseudo-random table (splitmix64), so chunks are reproducible
+// across builds and machines.
+constexpr GearTable makeGear() {
+    GearTable table{};
+    uint64_t x = 0x4d44354368756e6bULL;
+    for (size_t i = 0; i < 256; ++i) {
+        x += 0x9e3779b97f4a7c15ULL;
+        uint64_t z = x;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        table.v[i] = z ^ (z >> 31);
+    }
+    return table;
+}
+
+constexpr GearTable kGear = makeGear();
+
+// The top bits of the gear hash depend on the whole window
+uint64_t topBits(unsigned bits) {
+    return bits == 0 ? 0 : ~0ULL << (64 - bits);
+}
+
+unsigned log2Floor(uint32_t value) {
+    unsigned bits = 0;
+    while (value > 1) {
+        value >>= 1;
+        ++bits;
+    }
+    return bits;
+}
+
+// Same work splitter as MD5Tree: items handed out one at a time
+template <typename Fn>
+void parallelFor(size_t begin, size_t end, unsigned threads, Fn fn) {
+#ifdef ARDUINO
+    (void)threads;
+    for (size_t i = begin; i < end; ++i) {
+        fn(i);
+    }
+#else
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t total = end - begin;
+    if (threads > total) {
+        threads = static_cast<unsigned>(std::max<size_t>(1, total));
+    }
+    std::atomic<size_t> next(begin);
+    auto worker = [&] {
+        for (size_t i = next++; i < end; i = next++) {
+            fn(i);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& th : pool) {
+        th.join();
+    }
+#endif
+}
+
+#ifndef ARDUINO
+// Buffers at least this large are scanned on several threads
+constexpr size_t kParallelScan = 1 << 20;
+constexpr size_t kFileWindow = 16 << 20;
+
+// Chunk ends inside a scanned segment where the loose mask matches;
+// `strict` marks those that also match the strict mask.
+struct Candidate {
+    size_t end;
+    bool strict;
+};
+#endif
+}
+
+MD5Chunker::MD5Chunker(uint32_t minSize, uint32_t avgSize, uint32_t maxSize) {
+    minSize_ = std::max<uint32_t>(minSize, kWindow);
+    avgSize_ = 1u << log2Floor(std::max(avgSize, 2 * minSize_));
+    maxSize_ = std::max(maxSize, avgSize_);
+    // Normalized chunking: two bits harder before the average, two easier after
+    const unsigned bits = log2Floor(avgSize_);
+    maskStrict_ = topBits(bits + 2);
+    maskLoose_ = topBits(bits > 2 ? bits - 2 : 1);
+}
+
+size_t MD5Chunker::cut(const uint8_t* data, size_t length) const {
+    if (length <= minSize_) {
+        return length;
+    }
+    const size_t normal = std::min<size_t>(avgSize_, length);
+    const size_t limit = std::min<size_t>(maxSize_, length);
+
+    // Warm the hash on the window before the first candidate position
+    uint64_t hash = 0;
+    size_t i = minSize_ - kWindow;
+    for (; i < minSize_; ++i) {
+        hash = (hash << 1) + kGear.v[data[i]];
+    }
+    for (; i < normal; ++i) {
+        hash = (hash << 1) + kGear.v[data[i]];
+        if ((hash & maskStrict_) == 0) {
+            return i + 1;
+        }
+    }
+    for (; i < limit; ++i) {
+        hash = (hash << 1) + kGear.v[data[i]];
+        if ((hash & maskLoose_) == 0) {
+            return i + 1;
+        }
+    }
+    return limit;
+}
+
+// Appends the chunk ends found in data[0, length) to `ends` and returns the
+// bytes consumed. Unless `final`, the tail that could still grow into a
+// longer chunk (less than maxSize_ bytes) is left unconsumed.
+size_t MD5Chunker::cutPoints(const uint8_t* data, size_t length, bool final, unsigned threads,
+                             std::vector<size_t>& ends) const {
+    size_t start = 0;
+#ifndef ARDUINO
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (threads > 1 && length >= kParallelScan) {
+        // Every position's hash only depends on the previous 64 bytes, so
+        // segments are scanned independently (warming up on the bytes just
+        // before them) and the min/avg/max rules are applied afterwards.
+        const size_t segments = threads * 4;
+        const size_t segmentSize = (length + segments - 1) / segments;
+        std::vector<std::vector<Candidate>> found(segments);
+        parallelFor(0, segments, threads, [&](size_t s) {
+            const size_t begin = std::min(length, s * segmentSize);
+            const size_t end = std::min(length, begin + segmentSize);
+            uint64_t hash = 0;
+            for (size_t i = begin >= kWindow ? begin - kWindow : 0; i < begin; ++i) {
+                hash = (hash << 1) + kGear.v[data[i]];
+            }
+            std::vector<Candidate>& out = found[s];
+            for (size_t i = begin; i < end; ++i) {
+                hash = (hash << 1) + kGear.v[data[i]];
+                if ((hash & maskLoose_) == 0) {
+                    out.push_back({i + 1, (hash & maskStrict_) == 0});
+                }
+            }
+        });
+
+        std::vector<Candidate> candidates;
+        for (const auto& segment : found) {
+            candidates.insert(candidates.end(), segment.begin(), segment.end());
+        }
+
+        size_t next = 0;
+        while (start < length && (final || length - start >= maxSize_)) {
+            const size_t remaining = length - start;
+            size_t cutEnd = start + std::min<size_t>(maxSize_, remaining);
+            if (remaining <= minSize_) {
+                cutEnd = length;
+            } else {
+                const size_t normal = start + std::min<size_t>(avgSize_, remaining);
+                while (next < candidates.size() && candidates[next].end <= start + minSize_) {
+                    ++next;
+                }
+                size_t k = next;
+                bool done = false;
+                for (; k < candidates.size() && candidates[k].end <= normal; ++k) {
+                    if (candidates[k].strict) {
+                        cutEnd = candidates[k].end;
+                        done = true;
+                        break;
+                    }
+                }
+                if (!done && k < candidates.size() && candidates[k].end <= cutEnd) {
+                    cutEnd = candidates[k].end;
+                }
+            }
+            ends.push_back(cutEnd);
+            start = cutEnd;
+        }
+        return start;
+    }
+#else
+    (void)threads;
+#endif
+    while (start < length && (final || length - start >= maxSize_)) {
+        start += cut(data + start, length - start);
+        ends.push_back(start);
+    }
+    return start;
+}
+
+std::vector<size_t> MD5Chunker::cutPoints(const uint8_t* data, size_t length, unsigned threads) const {
+    std::vector<size_t> ends;
+    cutPoints(data, length, true, threads, ends);
+    return ends;
+}
+
+// Hash the first `count` chunks described by `ends` (relative to `data`)
+// and append them to `out` with offsets shifted by `baseOffset`.
+void MD5Chunker::fingerprint(const uint8_t* data, const std::vector<size_t>& ends, size_t count,
+                             uint64_t baseOffset, unsigned threads, std::vector<MD5Chunk>& out) const {
+    std::vector<MD5Input> inputs(count);
+    size_t begin = 0;
+    for (size_t i = 0; i < count; ++i) {
+        inputs[i] = {data + begin, ends[i] - begin};
+        begin = ends[i];
+    }
+
+    std::vector<MD5Bytes> digests(count);
+    constexpr size_t kGroup = 256;
+    parallelFor(0, (count + kGroup - 1) / kGroup, threads, [&](size_t g) {
+        const size_t first = g * kGroup;
+        MD5Multi::digestBatch(inputs.data() + first, std::min(kGroup, count - first), digests.data() + first);
+    });
+
+    out.reserve(out.size() + count);
+    for (size_t i = 0; i < count; ++i) {
+        const uint64_t offset = baseOffset + static_cast<uint64_t>(inputs[i].data - data);
+        out.push_back({offset, static_cast<uint32_t>(inputs[i].length), digests[i]});
+    }
+}
+
+std::vector<MD5Chunk> MD5Chunker::chunks(const uint8_t* data, size_t length, unsigned threads) const {
+    std::vector<size_t> ends;
+    cutPoints(data, length, true, threads, ends);
+    std::vector<MD5Chunk> out;
+    fingerprint(data, ends, ends.size(), 0, threads, out);
+    return out;
+}
+
+#ifdef ARDUINO
+bool MD5Chunker::chunkFile(fs::FS& fs, const char* path, std::vector<MD5Chunk>& out) const {
+    out.clear();
+    if (path == nullptr) {
+        return false;
+    }
+    File file = fs.open(path, "r");
+    if (!file) {
+        return false;
+    }
+
+    // Room for one maximum chunk of carry plus the next read
+    std::vector<uint8_t> buffer(2 * static_cast<size_t>(maxSize_));
+    std::vector<size_t> ends;
+    size_t filled = 0;
+    uint64_t consumedTotal = 0;
+    bool eof = false;
+    while (!eof || filled > 0) {
+        while (!eof && filled < buffer.size()) {
+            size_t readBytes = file.read(buffer.data() + filled, buffer.size() - filled);
+            if (readBytes == 0) {
+                eof = true;
+            }
+            filled += readBytes;
+        }
+        ends.clear();
+        size_t consumed = cutPoints(buffer.data(), filled, eof, 1, ends);
+        fingerprint(buffer.data(), ends, ends.size(), consumedTotal, 1, out);
+        std::memmove(buffer.data(), buffer.data() + consumed, filled - consumed);
+        filled -= consumed;
+        consumedTotal += consumed;
+    }
+    file.close();
+    return true;
+}
+#else
+bool MD5Chunker::chunkFile(const std::string& path, std::vector<MD5Chunk>& out, unsigned threads) const {
+    out.clear();
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    std::vector<uint8_t> buffer(kFileWindow + maxSize_);
+    std::vector<size_t> ends;
+    size_t filled = 0;
+    uint64_t consumedTotal = 0;
+    bool eof = false;
+    while (!eof || filled > 0) {
+        if (!eof) {
+            file.read(reinterpret_cast<char*>(buffer.data() + filled),
+                      static_cast<std::streamsize>(buffer.size() - filled));
+            filled += static_cast<size_t>(file.gcount());
+            if (file.bad()) {
+                return false;
+            }
+            eof = !file;
+        }
+        ends.clear();
+        size_t consumed = cutPoints(buffer.data(), filled, eof, threads, ends);
+        fingerprint(buffer.data(), ends, ends.size(), consumedTotal, threads, out);
+        std::memmove(buffer.data(), buffer.data() + consumed, filled - consumed);
+        filled -= consumed;
+        consumedTotal += consumed;
+    }
+    return true;
+}
+
+size_t MD5ChunkIndex::DigestHash::operator()(const MD5Bytes& digest) const {
+    // MD5 output is already uniformly distributed
+    size_t value = 0;
+    std::memcpy(&value, digest.data(), sizeof(value));
+    return value;
+}
+
+size_t MD5ChunkIndex::add(const std::string& path, const std::vector<MD5Chunk>& chunks) {
+    size_t added = 0;
+    for (const MD5Chunk& chunk : chunks) {
+        if (chunks_.emplace(chunk.digest, MD5ChunkLocation{path, chunk.offset, chunk.length}).second) {
+            uniqueBytes_ += chunk.length;
+            ++added;
+        }
+    }
+    return added;
+}
+
+const MD5ChunkLocation* MD5ChunkIndex::find(const MD5Bytes& digest) const {
+    auto it = chunks_.find(digest);
+    return it == chunks_.end() ? nullptr : &it->second;
+}
+
+bool MD5ChunkIndex::save(const std::string& path) const {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    file << "# md5-chunks v1\n";
+    char hex[32];
+    for (const auto& entry : chunks_) {
+        hexcodec::encode(entry.first.data(), entry.first.size(), hex);
+        file.write(hex, sizeof(hex));
+        file << ' ' << entry.second.offset << ' ' << entry.second.length << "  "
+             << entry.second.path << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+bool MD5ChunkIndex::load(const std::string& path) {
+    chunks_.clear();
+    uniqueBytes_ = 0;
+    std::ifstream file(path);
+    std::string line;
+    if (!file || !std::getline(file, line) || line != "# md5-chunks v1") {
+        return false;
+    }
+    while (std::getline(file, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        MD5Bytes digest{};
+        unsigned long long offset = 0;
+        unsigned long length = 0;
+        int pathStart = 0;
+        const bool ok = line.size() > 32 && line[32] == ' ' && hexcodec::decode(line.data(), 32, digest.data());
+        if (!ok || std::sscanf(line.c_str() + 33, "%llu %lu  %n", &offset, &length, &pathStart) != 2 ||
+            pathStart == 0) {
+            chunks_.clear();
+            uniqueBytes_ = 0;
+            return false;
+        }
+        MD5ChunkLocation location{line.substr(33 + pathStart), offset, static_cast<uint32_t>(length)};
+        if (chunks_.emplace(digest, location).second) {
+            uniqueBytes_ += length;
+        }
+    }
+    return true;
+}
+#endif
@@ -0,0 +1,301 @@
+#include "MD5Multi.h"
+
+#include "MD5.h"
+#include "hexcodec.h"
+
+#include <cstring>
+
+// The lane engine uses GCC/Clang vector extensions, which lower to SSE2,
+// AVX2, AVX-512 or NEON depending on the target. On the board (and other
+// compilers) the batch API simply hashes the inputs one by one.
+#if !defined(ARDUINO) && (defined(__GNUC__) || defined(__clang__))
+#define MD5_MULTI_SIMD 1
+#if defined(__x86_64__) || defined(__i386__)
+#define MD5_MULTI_X86 1
+#endif
+#endif
+
+namespace {
+
+constexpr uint32_t kK[64] = {
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+    0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+    0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+    0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+    0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+    0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391,
+};
+
+constexpr uint32_t kShift[64] = {
+    7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+    5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20,
+    4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+    6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21,
+};
+
+void encodeDigest(const uint32_t state[4], std::array<uint8_t, 16>& out) {
+    for (size_t i = 0; i < 4; ++i) {
+        out[4 * i] = static_cast<uint8_t>(state[i] & 0xff);
+        out[4 * i + 1] = static_cast<uint8_t>((state[i] >> 8) & 0xff);
+        out[4 * i + 2] = static_cast<uint8_t>((state[i] >> 16) & 0xff);
+        out[4 * i + 3] = static_cast<uint8_t>((state[i] >> 24) & 0xff);
+    }
+}
+
+#ifdef MD5_MULTI_SIMD
+
+#define MD5_ALWAYS_INLINE inline __attribute__((always_inline))
+
+// One message in flight in a lane. Whole blocks are read straight from the
+// caller's buffer; the padded tail (1 or 2 blocks) lives in `tail`.
+struct LaneJob {
+    const uint8_t* data;
+    size_t index;
+    size_t fullBlocks;
+    size_t totalBlocks;
+    size_t block;
+    uint32_t state[4];
+    uint8_t tail[128];
+
+    void start(const MD5Input& input, size_t idx, const uint32_t init[4], uint64_t prefixBytes) {
+        data = input.data;
+        index = idx;
+        fullBlocks = input.length / 64;
+        size_t rem = input.length % 64;
+        size_t tailBlocks = rem < 56 ? 1 : 2;
+        totalBlocks = fullBlocks + tailBlocks;
+        block = 0;
+        for (int k = 0; k < 4; ++k) {
+            state[k] = init[k];
+        }
+
+        std::memset(tail, 0, sizeof(tail));
+        if (rem > 0) {
+            std::memcpy(tail, data + fullBlocks * 64, rem);
+        }
+        tail[rem] = 0x80;
+        uint64_t bits = (prefixBytes + static_cast<uint64_t>(input.length)) * 8ULL;
+        uint8_t* len = tail + tailBlocks * 64 - 8;
+        for (size_t i = 0; i < 8; ++i) {
+            len[i] = static_cast<uint8_t>((bits >> (8 * i)) & 0xff);
+        }
+    }
+
+    const uint8_t* nextBlock() const {
+        return block < fullBlocks ? data + block * 64 : tail + (block - fullBlocks) * 64;
+    }
+};
+
+template <int N>
+struct LaneVec {
+    typedef uint32_t V __attribute__((vector_size(4 * N)));
+};
+
+// Run the 64 MD5 steps on N lanes: S[k][lane] is the chaining state,
+// X[w][lane] the message word w of each lane's current block.
+template <int N>
+MD5_ALWAYS_INLINE void compressLanes(uint32_t (&S)[4][N], const uint32_t (&X)[16][N]) {
+    typedef typename LaneVec<N>::V V;
+    V a, b, c, d, m[16];
+    std::memcpy(&a, S[0], sizeof(V));
+    std::memcpy(&b, S[1], sizeof(V));
+    std::memcpy(&c, S[2], sizeof(V));
+    std::memcpy(&d, S[3], sizeof(V));
+    for (int w = 0; w < 16; ++w) {
+        std::memcpy(&m[w], X[w], sizeof(V));
+    }
+    const V a0 = a, b0 = b, c0 = c, d0 = d;
+
+#pragma GCC unroll 64
+    for (int i = 0; i < 64; ++i) {
+        V f;
+        int g;
+        if (i < 16) {
+            f = (b & c) | (~b & d);
+            g = i;
+        } else if (i < 32) {
+            f = (b & d) | (c & ~d);
+            g = (5 * i + 1) & 15;
+        } else if (i < 48) {
+            f = b ^ c ^ d;
+            g = (3 * i + 5) & 15;
+        } else {
+            f = c ^ (b | ~d);
+            g = (7 * i) & 15;
+        }
+        f = f + a + kK[i] + m[g];
+        a = d;
+        d = c;
+        c = b;
+        b = b + ((f << kShift[i]) | (f >> (32 - kShift[i])));
+    }
+
+    a += a0;
+    b += b0;
+    c += c0;
+    d += d0;
+    std::memcpy(S[0], &a, sizeof(V));
+    std::memcpy(S[1], &b, sizeof(V));
+    std::memcpy(S[2], &c, sizeof(V));
+    std::memcpy(S[3], &d, sizeof(V));
+}
+
+template <int N>
+MD5_ALWAYS_INLINE void runLanes(const MD5Input* inputs, size_t count, std::array<uint8_t, 16>* out,
+                                const uint32_t init[4], uint64_t prefixBytes) {
+    LaneJob jobs[N];
+    bool active[N];
+    size_t next = 0;
+    size_t running = 0;
+    for (int l = 0; l < N; ++l) {
+        active[l] = next < count;
+        if (active[l]) {
+            jobs[l].start(inputs[next], next, init, prefixBytes);
+            ++next;
+            ++running;
+        }
+    }
+
+    alignas(64) uint32_t S[4][N];
+    alignas(64) uint32_t X[16][N];
+    while (running > 0) {
+        // Transpose: word w of lane l goes to X[w][l]
+        for (int l = 0; l < N; ++l) {
+            if (!active[l]) {
+                for (int w = 0; w < 16; ++w) X[w][l] = 0;
+                continue;
+            }
+            const uint8_t* p = jobs[l].nextBlock();
+            for (int w = 0; w < 16; ++w) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+                std::memcpy(&X[w][l], p + 4 * w, 4);
+#else
+                X[w][l] = static_cast<uint32_t>(p[4 * w]) |
+                          (static_cast<uint32_t>(p[4 * w + 1]) << 8) |
+                          (static_cast<uint32_t>(p[4 * w + 2]) << 16) |
+                          (static_cast<uint32_t>(p[4 * w + 3]) << 24);
+#endif
+            }
+            for (int k = 0; k < 4; ++k) S[k][l] = jobs[l].state[k];
+        }
+
+        compressLanes<N>(S, X);
+
+        for (int l = 0; l < N; ++l) {
+            if (!active[l]) {
+                continue;
+            }
+            LaneJob& job = jobs[l];
+            for (int k = 0; k < 4; ++k) job.state[k] = S[k][l];
+            if (++job.block < job.totalBlocks) {
+                continue;
+            }
+            encodeDigest(job.state, out[job.index]);
+            // Refill the lane as soon as its message is done
+            if (next < count) {
+                job.start(inputs[next], next, init, prefixBytes);
+                ++next;
+            } else {
+                active[l] = false;
+                --running;
+            }
+        }
+    }
+}
+
+void runLanes4(const MD5Input* inputs, size_t count, std::array<uint8_t, 16>* out,
+               const uint32_t init[4], uint64_t prefixBytes) {
+    runLanes<4>(inputs, count, out, init, prefixBytes);
+}
+
+#ifdef MD5_MULTI_X86
+__attribute__((target("avx2")))
+void runLanes8(const MD5Input* inputs, size_t count, std::array<uint8_t, 16>* out,
+               const uint32_t init[4], uint64_t prefixBytes) {
+    runLanes<8>(inputs, count, out, init, prefixBytes);
+}
+
+__attribute__((target("avx512f")))
+void runLanes16(const MD5Input* inputs, size_t count, std::array<uint8_t, 16>* out,
+               const uint32_t init[4], uint64_t prefixBytes) {
+    runLanes<16>(inputs, count, out, init, prefixBytes);
+}
+#endif
+
+#endif // MD5_MULTI_SIMD
+}
+
+size_t MD5Multi::lanes() {
+#if defined(MD5_MULTI_X86)
+    if (__builtin_cpu_supports("avx512f")) {
+        return 16;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return 8;
+    }
+    return 4;
+#elif defined(MD5_MULTI_SIMD)
+    return 4;
+#else
+    return 1;
+#endif
+}
+
+void MD5Multi::digestBatch(const MD5Input* inputs, size_t count, std::array<uint8_t, 16>* out) {
+    MD5 empty;
+    digestBatch(empty, inputs, count, out);
+}
+
+void MD5Multi::digestBatch(const MD5& prefix, const MD5Input* inputs, size_t count,
+                           std::array<uint8_t, 16>* out) {
+    if (count == 0) {
+        return;
+    }
+#ifdef MD5_MULTI_SIMD
+    // Lanes start on a block boundary; a prefix with a pending partial block
+    // (or an already finalized one) takes the scalar path below.
+    const uint64_t prefixBytes = prefix.bitCount_ / 8;
+    if (!prefix.finalized_ && prefixBytes % 64 == 0) {
+        switch (lanes()) {
+#ifdef MD5_MULTI_X86
+        case 16:
+            runLanes16(inputs, count, out, prefix.state_, prefixBytes);
+            return;
+        case 8:
+            runLanes8(inputs, count, out, prefix.state_, prefixBytes);
+            return;
+#endif
+        default:
+            runLanes4(inputs, count, out, prefix.state_, prefixBytes);
+            return;
+        }
+    }
+#endif
+    for (size_t i = 0; i < count; ++i) {
+        MD5 md5 = prefix;
+        md5.update(inputs[i].data, inputs[i].length);
+        out[i] = md5.digest();
+    }
+}
+
+std::vector<std::array<uint8_t, 16>> MD5Multi::digestBatch(const std::vector<MD5Input>& inputs) {
+    std::vector<std::array<uint8_t, 16>> out(inputs.size());
+    digestBatch(inputs.data(), inputs.size(), out.data());
+    return out;
+}
+
+std::vector<std::string> MD5Multi::hashBatch(const std::vector<std::string>& inputs) {
+    std::vector<MD5Input> views(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        views[i] = {reinterpret_cast<const uint8_t*>(inputs[i].data()), inputs[i].size()};
+    }
+    auto digests = digestBatch(views);
+
+    std::vector<std::string> output(digests.size());
+    for (size_t i = 0; i < digests.size(); ++i) {
+        output[i] = hexcodec::encode(digests[i]);
+    }
+    return output;
+}
@@ -0,0 +1,185 @@
+#include "MD5Tree.h"
+
+#include "MD5.h"
+#include "hexcodec.h"
+
+#include <algorithm>
+
+#ifndef ARDUINO
+#include <atomic>
+#include <fstream>
+#include <thread>
+#endif
+
+namespace {
+constexpr uint8_t kLeafPrefix = 0x00;
+constexpr uint8_t kNodePrefix = 0x01;
+
+// Run fn(i) for every i in [begin, end); leaves are handed out one at a time
+// so uneven read times do not leave cores idle.
+template <typename Fn>
+void parallelFor(uint64_t begin, uint64_t end, unsigned threads, Fn fn) {
+#ifdef ARDUINO
+    (void)threads;
+    for (uint64_t i = begin; i < end; ++i) {
+        fn(i);
+    }
+#else
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    uint64_t total = end - begin;
+    if (threads > total) {
+        threads = static_cast<unsigned>(std::max<uint64_t>(1, total));
+    }
+    std::atomic<uint64_t> next(begin);
+    auto worker = [&] {
+        for (uint64_t i = next++; i < end; i = next++) {
+            fn(i);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& th : pool) {
+        th.join();
+    }
+#endif
+}
+}
+
+std::string MD5TreeDigest::hexdigest() const {
+    return "md5tree-" + std::to_string(leafSize) + ":" + hexcodec::encode(root);
+}
+
+MD5Tree::MD5Tree(uint32_t leafSize) : leafSize_(leafSize == 0 ? kDefaultLeafSize : leafSize) {}
+
+uint64_t MD5Tree::leafCount(uint64_t length) const {
+    // An empty input still has one (empty) leaf
+    return length == 0 ? 1 : (length + leafSize_ - 1) / leafSize_;
+}
+
+MD5Bytes MD5Tree::hashLeaf(const uint8_t* data, size_t length) {
+    MD5 md5;
+    md5.update(&kLeafPrefix, 1);
+    md5.update(data, length);
+    return md5.digest();
+}
+
+MD5Bytes MD5Tree::rootFromLeaves(const std::vector<MD5Bytes>& leaves) {
+    if (leaves.empty()) {
+        return hashLeaf(nullptr, 0);
+    }
+    std::vector<MD5Bytes> level = leaves;
+    while (level.size() > 1) {
+        std::vector<MD5Bytes> up;
+        up.reserve((level.size() + 1) / 2);
+        for (size_t i = 0; i + 1 < level.size(); i += 2) {
+            MD5 md5;
+            md5.update(&kNodePrefix, 1);
+            md5.update(level[i].data(), level[i].size());
+            md5.update(level[i + 1].data(), level[i + 1].size());
+            up.push_back(md5.digest());
+        }
+        if (level.size() % 2 != 0) {
+            up.push_back(level.back());
+        }
+        level.swap(up);
+    }
+    return level[0];
+}
+
+std::vector<MD5Bytes> MD5Tree::leafDigests(const uint8_t* data, size_t length, unsigned threads) const {
+    std::vector<MD5Bytes> leaves(static_cast<size_t>(leafCount(length)));
+    parallelFor(0, leaves.size(), threads, [&](uint64_t i) {
+        size_t offset = static_cast<size_t>(i * leafSize_);
+        size_t size = std::min<size_t>(leafSize_, length - offset);
+        leaves[static_cast<size_t>(i)] = hashLeaf(data + offset, size);
+    });
+    return leaves;
+}
+
+MD5TreeDigest MD5Tree::hash(const uint8_t* data, size_t length, unsigned threads) const {
+    return {rootFromLeaves(leafDigests(data, length, threads)), length, leafSize_};
+}
+
+#ifndef ARDUINO
+namespace {
+uint64_t fileLength(const std::string& path, bool& ok) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    ok = static_cast<bool>(file);
+    return ok ? static_cast<uint64_t>(file.tellg()) : 0;
+}
+}
+
+bool MD5Tree::rehashLeafRange(const std::string& path, std::vector<MD5Bytes>& leaves,
+                              uint64_t first, uint64_t count, unsigned threads) const {
+    bool ok = false;
+    const uint64_t length = fileLength(path, ok);
+    if (!ok) {
+        return false;
+    }
+    const uint64_t total = leafCount(length);
+    leaves.resize(static_cast<size_t>(total));
+    if (first >= total) {
+        return true;
+    }
+    const uint64_t end = count > total - first ? total : first + count;
+
+    // Every worker reads whole leaves through its own stream
+    std::atomic<bool> failed(false);
+    parallelFor(first, end, threads, [&](uint64_t i) {
+        thread_local std::vector<char> buffer;
+        buffer.resize(leafSize_);
+        std::ifstream file(path, std::ios::binary);
+        uint64_t offset = i * leafSize_;
+        size_t size = static_cast<size_t>(std::min<uint64_t>(leafSize_, length - offset));
+        file.seekg(static_cast<std::streamoff>(offset));
+        file.read(buffer.data(), static_cast<std::streamsize>(size));
+        if (!file || static_cast<size_t>(file.gcount()) != size) {
+            failed = true;
+            return;
+        }
+        leaves[static_cast<size_t>(i)] = hashLeaf(reinterpret_cast<const uint8_t*>(buffer.data()), size);
+    });
+    return !failed;
+}
+
+bool MD5Tree::verifyLeafRange(const std::string& path, const std::vector<MD5Bytes>& leaves,
+                              uint64_t first, uint64_t count, unsigned threads) const {
+    std::vector<MD5Bytes> current = leaves;
+    if (!rehashLeafRange(path, current, first, count, threads) || current.size() != leaves.size()) {
+        return false;
+    }
+    if (first >= leaves.size()) {
+        return true;
+    }
+    const uint64_t end = count > leaves.size() - first ? leaves.size() : first + count;
+    for (uint64_t i = first; i < end; ++i) {
+        if (current[static_cast<size_t>(i)] != leaves[static_cast<size_t>(i)]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<MD5Bytes> MD5Tree::leafDigests(const std::string& path, unsigned threads) const {
+    std::vector<MD5Bytes> leaves;
+    if (!rehashLeafRange(path, leaves, 0, UINT64_MAX, threads)) {
+        return {};
+    }
+    return leaves;
+}
+
+MD5TreeDigest MD5Tree::hashFile(const std::string& path, unsigned threads) const {
+    bool ok = false;
+    const uint64_t length = fileLength(path, ok);
+    std::vector<MD5Bytes> leaves = leafDigests(path, threads);
+    if (!ok || leaves.empty()) {
+        return {MD5Bytes{}, 0, leafSize_};
+    }
+    return {rootFromLeaves(leaves), length, leafSize_};
+}
+#endif
@@ -0,0 +1,159 @@
+#include "MultiDigest.h"
+
+#include <cstdint>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace {
+#ifndef ARDUINO
+// A small ring of large chunks: the reader refills a slot once every digest
+// has consumed it, each digest walks the ring at its own pace.
+constexpr size_t kChunkSize = 1 << 20;
+constexpr size_t kSlots = 4;
+
+class ChunkRing {
+public:
+    ChunkRing(Digest* const* digests, size_t count) : digests_(digests), count_(count) {
+        for (auto& slot : slots_) {
+            slot.data.resize(kChunkSize);
+        }
+    }
+
+    bool run(std::ifstream& file) {
+        std::vector<std::thread> workers;
+        workers.reserve(count_);
+        for (size_t i = 0; i < count_; ++i) {
+            workers.emplace_back([this, i] { consume(digests_[i]); });
+        }
+
+        bool ok = true;
+        for (uint64_t seq = 0;; ++seq) {
+            Slot& slot = slots_[seq % kSlots];
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                ready_.wait(lock, [&] { return slot.pending == 0; });
+            }
+            file.read(reinterpret_cast<char*>(slot.data.data()), kChunkSize);
+            const size_t n = static_cast<size_t>(file.gcount());
+            if (file.bad()) {
+                ok = false;
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (n == 0 || !ok) {
+                done_ = true;
+                ready_.notify_all();
+                break;
+            }
+            slot.length = n;
+            slot.pending = count_;
+            ++produced_;
+            ready_.notify_all();
+        }
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        return ok;
+    }
+
+private:
+    struct Slot {
+        std::vector<uint8_t> data;
+        size_t length = 0;
+        size_t pending = 0;  // digests that still have to read this slot
+    };
+
+    void consume(Digest* digest) {
+        for (uint64_t seq = 0;; ++seq) {
+            Slot& slot = slots_[seq % kSlots];
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                ready_.wait(lock, [&] { return produced_ > seq || done_; });
+                if (produced_ <= seq) {
+                    return;
+                }
+            }
+            digest->update(slot.data.data(), slot.length);
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--slot.pending == 0) {
+                ready_.notify_all();
+            }
+        }
+    }
+
+    Digest* const* digests_;
+    size_t count_;
+    Slot slots_[kSlots];
+    uint64_t produced_ = 0;
+    bool done_ = false;
+    std::mutex mutex_;
+    std::condition_variable ready_;
+};
+#endif
+}
+
+#ifdef ARDUINO
+bool multiDigestFile(fs::FS& fs, const char* path, Digest* const* digests, size_t count) {
+    if (path == nullptr) {
+        return false;
+    }
+
+    File file = fs.open(path, "r");
+    if (!file) {
+        return false;
+    }
+
+    std::vector<uint8_t> block(4096);
+    while (file.available()) {
+        size_t readBytes = file.read(block.data(), block.size());
+        if (readBytes == 0) {
+            break;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            digests[i]->update(block.data(), readBytes);
+        }
+    }
+    file.close();
+    return true;
+}
+
+bool multiDigestFile(fs::FS& fs, const char* path, const std::vector<Digest*>& digests) {
+    return multiDigestFile(fs, path, digests.data(), digests.size());
+}
+#else
+bool multiDigestFile(const std::string& path, Digest* const* digests, size_t count) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    if (count <= 1) {
+        std::vector<uint8_t> block(kChunkSize);
+        while (file) {
+            file.read(reinterpret_cast<char*>(block.data()), block.size());
+            const size_t n = static_cast<size_t>(file.gcount());
+            if (n == 0) {
+                break;
+            }
+            if (count == 1) {
+                digests[0]->update(block.data(), n);
+            }
+        }
+        return !file.bad();
+    }
+
+    ChunkRing ring(digests, count);
+    return ring.run(file);
+}
+
+bool multiDigestFile(const std::string& path, const std::vector<Digest*>& digests) {
+    return multiDigestFile(path, digests.data(), digests.size());
+}
+#endif
@@ -3,12 +3,27 @@
 
 #include <string>
 
+#include "HmacMD5.h"
 #include "MD5.h"
+#include "MD5Constexpr.h"
+#include "MD5Multi.h"
+#include "MultiDigest.h"
+#ifdef MD5_BENCHMARK
+#include "MD5Bench.h"
+#endif
 
 namespace {
 constexpr const char* kSampleFile = "/md5_sample.txt";
-constexpr const char* kExpectedTexto = "5df9f63916ebf8528697b629022993e8";
-constexpr const char* kExpectedVacio = "d41d8cd98f00b204e9800998ecf8427e";
+constexpr char kExpectedTexto[] = "5df9f63916ebf8528697b629022993e8";
+constexpr char kExpectedVacio[] = "d41d8cd98f00b204e9800998ecf8427e";
+
+// Los mismos resumenes calculados por el compilador (cero coste al arrancar)
+constexpr md5c::Digest kDigestTexto = md5c::digest("Generando un MD5 de un texto");
+static_assert(md5c::equal(kDigestTexto, md5c::fromHex(kExpectedTexto)), "MD5 constexpr del texto");
+static_assert(md5c::equal(md5c::digest(""), md5c::fromHex(kExpectedVacio)), "MD5 constexpr vacio");
+// RFC 2202, casos 1 y 2 de HMAC-MD5
+constexpr const char* kExpectedHmac1 = "9294727a3638bb1c13f48ef8158bfc9d";
+constexpr const char* kExpectedHmac2 = "750c783e6ab0b503eaa86e310a5db738";
 
 bool ensureFileWithContent(const char* path, const std::string& content) {
     if (SPIFFS.exists(path)) {
@@ -53,6 +68,16 @@ void setup() {
     const std::string digestVacio = MD5::hash(std::string());
     logDigest("MD5(\"\")", digestVacio, kExpectedVacio);
 
+    const auto lote = MD5Multi::hashBatch({texto, std::string()});
+    Serial.printf("MD5 por lotes (%u carriles):\n", static_cast<unsigned>(MD5Multi::lanes()));
+    logDigest("  lote[0]", lote[0], kExpectedTexto);
+    logDigest("  lote[1]", lote[1], kExpectedVacio);
+
+    const HmacMD5 hmac1(std::string(16, '\x0b'));
+    logDigest("HMAC-MD5(0x0b x16, \"Hi There\")", hmac1.hash("Hi There"), kExpectedHmac1);
+    const HmacMD5 hmac2("Jefe");
+    logDigest("HMAC-MD5(\"Jefe\", ...)", hmac2.hash("what do ya want for nothing?"), kExpectedHmac2);
+
     if (!ensureFileWithContent(kSampleFile, texto)) {
         Serial.printf("No se pudo preparar el fichero %s\n", kSampleFile);
         return;
@@ -60,6 +85,20 @@ void setup() {
 
     const std::string digestFichero = MD5::hashFile(SPIFFS, kSampleFile);
     logDigest("MD5 fichero de ejemplo", digestFichero, kExpectedTexto);
+
+    // MD5 y HMAC-MD5 del mismo fichero leyendolo una sola vez
+    MD5 md5Pasada;
+    HmacMD5 hmacPasada("Jefe");
+    if (multiDigestFile(SPIFFS, kSampleFile, {&md5Pasada, &hmacPasada})) {
+        logDigest("  una pasada: MD5", md5Pasada.hexResult(), kExpectedTexto);
+        logDigest("  una pasada: HMAC-MD5", hmacPasada.hexResult(), hmacPasada.hash(texto).c_str());
+    }
+
+#ifdef MD5_BENCHMARK
+    const MD5BenchResult bench = runMD5Benchmark(64 * 1024, 16);
+    Serial.printf("Benchmark MD5: referencia %.2f MB/s, optimizado %.2f MB/s [%s]\n",
+                  bench.referenceMBs, bench.tunedMBs, bench.sameDigest ? "OK" : "ERROR");
+#endif
 }
 
 void loop() {
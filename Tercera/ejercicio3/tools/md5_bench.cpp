@@ -0,0 +1,21 @@
+/* Host benchmark: tuned MD5 compression core vs. the pre-optimization
+ * reference (include/MD5Reference.h). On the board, build the "bench"
+ * PlatformIO environment instead; setup() prints the same numbers.
+ *
+ * Build (from Tercera/ejercicio3):
+ *   g++ -std=c++17 -O2 -pthread -Iinclude -I../lib/hexcodec tools/md5_bench.cpp src/MD5.cpp src/MD5Bench.cpp \
+ *       ../lib/hexcodec/hexcodec.cpp -o md5_bench
+ */
+
+#include "MD5Bench.h"
+
+#include <cstdio>
+
+int main() {
+    MD5BenchResult r = runMD5Benchmark(1 << 20, 256);
+    std::printf("reference: %8.1f MB/s\n", r.referenceMBs);
+    std::printf("tuned:     %8.1f MB/s (x%.2f)\n", r.tunedMBs,
+                r.referenceMBs > 0 ? r.tunedMBs / r.referenceMBs : 0.0);
+    std::printf("digests %s\n", r.sameDigest ? "match" : "DIFFER");
+    return r.sameDigest ? 0 : 1;
+}
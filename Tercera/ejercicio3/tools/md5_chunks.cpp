@@ -0,0 +1,83 @@
+/* Host tool: content-defined chunking of files with MD5 fingerprints and a
+ * persistent chunk index. Prints, for every file, how many chunks and bytes
+ * were already known (and where), then saves the updated index.
+ *
+ * Build (from Tercera/ejercicio3):
+ *   g++ -std=c++17 -O2 -pthread -Iinclude -I../lib/hexcodec tools/md5_chunks.cpp src/MD5.cpp src/MD5Multi.cpp \
+ *       src/MD5Chunker.cpp ../lib/hexcodec/hexcodec.cpp -o md5_chunks
+ *
+ * Usage: md5_chunks [--sizes min:avg:max] <index> <file>...
+ *   e.g. md5_chunks --sizes 64:128:1024 chunks.idx data/Preguntas_Moodle_*.txt
+ */
+
+#include "MD5Chunker.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+int main(int argc, char** argv) {
+    int arg = 1;
+    unsigned minSize = MD5Chunker::kDefaultMinSize;
+    unsigned avgSize = MD5Chunker::kDefaultAvgSize;
+    unsigned maxSize = MD5Chunker::kDefaultMaxSize;
+    if (arg + 1 < argc && std::strcmp(argv[arg], "--sizes") == 0) {
+        if (std::sscanf(argv[arg + 1], "%u:%u:%u", &minSize, &avgSize, &maxSize) != 3) {
+            std::fprintf(stderr, "bad --sizes, expected min:avg:max\n");
+            return 2;
+        }
+        arg += 2;
+    }
+    if (argc - arg < 2) {
+        std::fprintf(stderr, "usage: %s [--sizes min:avg:max] <index> <file>...\n", argv[0]);
+        return 2;
+    }
+
+    const MD5Chunker chunker(minSize, avgSize, maxSize);
+    const std::string indexPath = argv[arg++];
+    MD5ChunkIndex index;
+    if (index.load(indexPath)) {
+        std::printf("index: %zu chunks (%llu bytes)\n", index.size(),
+                    static_cast<unsigned long long>(index.uniqueBytes()));
+    }
+
+    int status = 0;
+    for (; arg < argc; ++arg) {
+        std::vector<MD5Chunk> chunks;
+        const auto start = std::chrono::steady_clock::now();
+        if (!chunker.chunkFile(argv[arg], chunks)) {
+            std::fprintf(stderr, "cannot read %s\n", argv[arg]);
+            status = 1;
+            continue;
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        uint64_t total = 0;
+        uint64_t known = 0;
+        size_t knownChunks = 0;
+        for (const MD5Chunk& chunk : chunks) {
+            total += chunk.length;
+            if (const MD5ChunkLocation* location = index.find(chunk.digest)) {
+                known += chunk.length;
+                ++knownChunks;
+                if (location->path != argv[arg]) {
+                    std::printf("  @%llu +%u = %s @%llu\n", static_cast<unsigned long long>(chunk.offset),
+                                chunk.length, location->path.c_str(),
+                                static_cast<unsigned long long>(location->offset));
+                }
+            }
+        }
+        index.add(argv[arg], chunks);
+        std::printf("%s: %zu chunks, %zu known (%llu of %llu bytes), %.1f MB/s\n", argv[arg], chunks.size(),
+                    knownChunks, static_cast<unsigned long long>(known), static_cast<unsigned long long>(total),
+                    seconds > 0 ? total / seconds / 1e6 : 0.0);
+    }
+
+    if (!index.save(indexPath)) {
+        std::fprintf(stderr, "cannot write %s\n", indexPath.c_str());
+        return 1;
+    }
+    std::printf("index: %zu chunks (%llu bytes)\n", index.size(),
+                static_cast<unsigned long long>(index.uniqueBytes()));
+    return status;
+}
@@ -0,0 +1,47 @@
+/* Host tool: MD5, HMAC-MD5 and CBC-MAC (from Tercera/ejercicio2) of a file
+ * in a single read pass, each digest on its own core.
+ *
+ * Build (from Tercera/ejercicio3):
+ *   gcc -O2 -c ../ejercicio2/lib/aes/aes.c -o aes.o
+ *   g++ -std=c++17 -O2 -pthread -Iinclude -I../ejercicio2/include -I../ejercicio2/lib/aes -I../lib/hexcodec \
+ *       tools/multi_digest.cpp src/MD5.cpp src/HmacMD5.cpp src/MD5Multi.cpp src/MultiDigest.cpp \
+ *       ../ejercicio2/src/cbc_mac.cpp ../lib/hexcodec/hexcodec.cpp aes.o -o multi_digest
+ *
+ * Usage: multi_digest <file> [hmac-key]
+ */
+
+#include "CBCMAC.h"
+#include "HmacMD5.h"
+#include "MD5.h"
+#include "MultiDigest.h"
+
+#include <chrono>
+#include <cstdio>
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <file> [hmac-key]\n", argv[0]);
+        return 2;
+    }
+
+    // Same fixed key as the CBC-MAC exercise
+    const uint8_t key[16] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+                             0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10};
+    MD5 md5;
+    HmacMD5 hmac(argc > 2 ? argv[2] : "key");
+    MacDigest<CBCMAC> cbc("cbc-mac", key);
+    std::vector<Digest*> digests = {&md5, &hmac, &cbc};
+
+    const auto start = std::chrono::steady_clock::now();
+    if (!multiDigestFile(argv[1], digests)) {
+        std::fprintf(stderr, "cannot read %s\n", argv[1]);
+        return 1;
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (Digest* digest : digests) {
+        std::printf("%-9s %s\n", digest->name(), digest->hexResult().c_str());
+    }
+    std::printf("%.3f s\n", seconds);
+    return 0;
+}
@@ -0,0 +1,214 @@
+#include "hexcodec.h"
+
+#if !defined(ARDUINO) && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define HEXCODEC_X86 1
+#include <immintrin.h>
+#elif !defined(ARDUINO) && defined(__aarch64__)
+#define HEXCODEC_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+constexpr char kDigits[] = "0123456789abcdef";
+constexpr uint8_t kInvalid = 0xFF;
+
+struct EncodeTable {
+    char pair[256][2];
+};
+
+struct DecodeTable {
+    uint8_t nibble[256];
+};
+
+constexpr EncodeTable makeEncodeTable() {
+    EncodeTable table{};
+    for (int i = 0; i < 256; ++i) {
+        table.pair[i][0] = kDigits[i >> 4];
+        table.pair[i][1] = kDigits[i & 0x0F];
+    }
+    return table;
+}
+
+constexpr DecodeTable makeDecodeTable() {
+    DecodeTable table{};
+    for (int i = 0; i < 256; ++i) {
+        table.nibble[i] = (i >= '0' && i <= '9') ? static_cast<uint8_t>(i - '0')
+                        : (i >= 'a' && i <= 'f') ? static_cast<uint8_t>(i - 'a' + 10)
+                        : (i >= 'A' && i <= 'F') ? static_cast<uint8_t>(i - 'A' + 10)
+                        : kInvalid;
+    }
+    return table;
+}
+
+constexpr EncodeTable kEncode = makeEncodeTable();
+constexpr DecodeTable kDecode = makeDecodeTable();
+
+void encodeScalar(const uint8_t* data, size_t length, char* out) {
+    for (size_t i = 0; i < length; ++i) {
+        out[2 * i] = kEncode.pair[data[i]][0];
+        out[2 * i + 1] = kEncode.pair[data[i]][1];
+    }
+}
+
+// Bytes [0, length) from hex[0, 2 * length); false with *errorAt set on
+// the first invalid character.
+bool decodeScalar(const char* hex, size_t length, uint8_t* out, size_t* errorAt) {
+    for (size_t i = 0; i < length; ++i) {
+        const uint8_t hi = kDecode.nibble[static_cast<uint8_t>(hex[2 * i])];
+        const uint8_t lo = kDecode.nibble[static_cast<uint8_t>(hex[2 * i + 1])];
+        if (hi == kInvalid || lo == kInvalid) {
+            *errorAt = 2 * i + (hi == kInvalid ? 0 : 1);
+            return false;
+        }
+        out[i] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+    return true;
+}
+
+#ifdef HEXCODEC_X86
+// The vector loops return how many bytes they handled (a multiple of 16);
+// the caller finishes the tail, or locates the error, with the tables.
+__attribute__((target("ssse3")))
+size_t encodeSSSE3(const uint8_t* data, size_t length, char* out) {
+    const __m128i digits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kDigits));
+    const __m128i low = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(v, 4), low));
+        const __m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(v, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+    return i;
+}
+
+// 16 characters to 16 nibble values; `valid` gets 0xFF per hex digit.
+__attribute__((target("ssse3")))
+inline __m128i nibblesSSSE3(__m128i c, __m128i& valid) {
+    const __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    const __m128i letter = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+    valid = _mm_or_si128(isDigit, isLetter);
+    return _mm_or_si128(_mm_and_si128(isDigit, digit),
+                        _mm_and_si128(isLetter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+__attribute__((target("ssse3")))
+size_t decodeSSSE3(const char* hex, size_t length, uint8_t* out) {
+    // (hi, lo) pairs -> hi * 16 + lo in each 16-bit lane
+    const __m128i weights = _mm_set1_epi16(0x0110);
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i validA;
+        __m128i validB;
+        const __m128i a = nibblesSSSE3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + 2 * i)), validA);
+        const __m128i b = nibblesSSSE3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + 2 * i + 16)), validB);
+        if (_mm_movemask_epi8(_mm_and_si128(validA, validB)) != 0xFFFF) {
+            break;
+        }
+        const __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(a, weights), _mm_maddubs_epi16(b, weights));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), bytes);
+    }
+    return i;
+}
+
+bool haveSSSE3() {
+    static const bool supported = __builtin_cpu_supports("ssse3");
+    return supported;
+}
+#endif
+
+#ifdef HEXCODEC_NEON
+size_t encodeNEON(const uint8_t* data, size_t length, char* out) {
+    const uint8x16_t digits = vld1q_u8(reinterpret_cast<const uint8_t*>(kDigits));
+    const uint8x16_t low = vdupq_n_u8(0x0F);
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        const uint8x16_t v = vld1q_u8(data + i);
+        uint8x16x2_t pairs;
+        pairs.val[0] = vqtbl1q_u8(digits, vshrq_n_u8(v, 4));
+        pairs.val[1] = vqtbl1q_u8(digits, vandq_u8(v, low));
+        vst2q_u8(reinterpret_cast<uint8_t*>(out + 2 * i), pairs);  // interleaves hi, lo
+    }
+    return i;
+}
+
+inline uint8x16_t nibblesNEON(uint8x16_t c, uint8x16_t& valid) {
+    const uint8x16_t digit = vsubq_u8(c, vdupq_n_u8('0'));
+    const uint8x16_t isDigit = vcleq_u8(digit, vdupq_n_u8(9));
+    const uint8x16_t letter = vsubq_u8(vorrq_u8(c, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    const uint8x16_t isLetter = vcleq_u8(letter, vdupq_n_u8(5));
+    valid = vorrq_u8(isDigit, isLetter);
+    return vbslq_u8(isDigit, digit, vaddq_u8(letter, vdupq_n_u8(10)));
+}
+
+size_t decodeNEON(const char* hex, size_t length, uint8_t* out) {
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        // De-interleave: val[0] = high-nibble characters, val[1] = low
+        const uint8x16x2_t chars = vld2q_u8(reinterpret_cast<const uint8_t*>(hex + 2 * i));
+        uint8x16_t validHi;
+        uint8x16_t validLo;
+        const uint8x16_t hi = nibblesNEON(chars.val[0], validHi);
+        const uint8x16_t lo = nibblesNEON(chars.val[1], validLo);
+        if (vminvq_u8(vandq_u8(validHi, validLo)) != 0xFF) {
+            break;
+        }
+        vst1q_u8(out + i, vorrq_u8(vshlq_n_u8(hi, 4), lo));
+    }
+    return i;
+}
+#endif
+}
+
+namespace hexcodec {
+
+void encode(const uint8_t* data, size_t length, char* out) {
+    size_t done = 0;
+#if defined(HEXCODEC_X86)
+    if (haveSSSE3()) {
+        done = encodeSSSE3(data, length, out);
+    }
+#elif defined(HEXCODEC_NEON)
+    done = encodeNEON(data, length, out);
+#endif
+    encodeScalar(data + done, length - done, out + 2 * done);
+}
+
+std::string encode(const uint8_t* data, size_t length) {
+    std::string output(2 * length, '\0');
+    encode(data, length, &output[0]);
+    return output;
+}
+
+bool decode(const char* hex, size_t hexLength, uint8_t* out, size_t* errorAt) {
+    size_t position = hexLength;
+    if (hexLength % 2 != 0) {
+        if (errorAt != nullptr) {
+            *errorAt = position;
+        }
+        return false;
+    }
+
+    const size_t length = hexLength / 2;
+    size_t done = 0;
+#if defined(HEXCODEC_X86)
+    if (haveSSSE3()) {
+        done = decodeSSSE3(hex, length, out);
+    }
+#elif defined(HEXCODEC_NEON)
+    done = decodeNEON(hex, length, out);
+#endif
+    if (!decodeScalar(hex + 2 * done, length - done, out + done, &position)) {
+        if (errorAt != nullptr) {
+            *errorAt = 2 * done + position;
+        }
+        return false;
+    }
+    return true;
+}
+
+} // namespace hexcodec
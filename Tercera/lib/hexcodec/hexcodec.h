@@ -0,0 +1,49 @@
+/* Hex encoding/decoding shared by the Tercera projects (MD5 digests,
+ * CBC-MAC/PMAC manifests, OFB keys). Bulk conversions use SSSE3 or NEON
+ * when available, 16 bytes per step; the board uses 256-entry tables.
+ *
+ * Each PlatformIO project picks it up through `lib_extra_dirs = ../lib`;
+ * host tools add -I../lib/hexcodec and ../lib/hexcodec/hexcodec.cpp.
+ */
+#ifndef HEXCODEC_H
+#define HEXCODEC_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace hexcodec {
+
+// Write 2 * length lowercase hex digits to `out` (no terminator).
+void encode(const uint8_t* data, size_t length, char* out);
+std::string encode(const uint8_t* data, size_t length);
+
+template <size_t N>
+std::string encode(const std::array<uint8_t, N>& bytes) {
+    return encode(bytes.data(), N);
+}
+
+// Decode `hexLength` characters (either case) into hexLength / 2 bytes.
+// Returns false on an odd length or a non-hex character; `errorAt`, if
+// given, receives the position of the first bad character (hexLength for
+// an odd length). `out` may be partially written on failure.
+bool decode(const char* hex, size_t hexLength, uint8_t* out, size_t* errorAt = nullptr);
+
+// Exactly 2 * N characters of a NUL-terminated string into `out`.
+template <size_t N>
+bool decode(const char* hex, std::array<uint8_t, N>& out, size_t* errorAt = nullptr) {
+    const size_t length = std::strlen(hex);
+    if (length != 2 * N) {
+        if (errorAt != nullptr) {
+            *errorAt = length < 2 * N ? length : 2 * N;
+        }
+        return false;
+    }
+    return decode(hex, length, out.data(), errorAt);
+}
+
+} // namespace hexcodec
+
+#endif // HEXCODEC_H
@@ -0,0 +1,63 @@
+// Adaptador comun para sacar secuencias de bits largas de cada generador de
+// las practicas (MiRandom, LFSR, Geffe, Beth-Piper, Massey-Rueppel y el
+// cifrador OFB) y pasarlas a las pruebas NIST.
+//
+// La secuencia va empaquetada: el bit i esta en el bit i % 64 de la
+// palabra i / 64. Los generadores de bytes se leen con el bit mas
+// significativo primero, como los imprimen sus ejercicios.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class FuenteBits {
+public:
+    virtual ~FuenteBits() = default;
+
+    // Los siguientes 64 * palabras bits de la secuencia
+    virtual void generar(uint64_t *palabras, size_t cantidad) = 0;
+};
+
+// Adaptador para generadores de bytes
+class FuenteBytes : public FuenteBits {
+public:
+    void generar(uint64_t *palabras, size_t cantidad) override;
+
+protected:
+    virtual void bytes(uint8_t *salida, size_t longitud) = 0;
+};
+
+struct GeneradorDisponible {
+    const char *nombre;
+    const char *clave;        // formato de la clave en la linea de ordenes
+    const char *porDefecto;   // clave de los ejemplos de las practicas
+};
+
+const std::vector<GeneradorDisponible> &generadoresDisponibles();
+
+// nullptr (y `error` rellenado) si el generador no existe o la clave no vale
+std::unique_ptr<FuenteBits> crearFuente(const std::string &generador, const std::string &clave,
+                                        std::string &error);
+
+// Cada generador de LFSR se compila en su propia unidad (todos los .h de
+// Segunda definen su propia clase LFSR). Clave de 9 bytes por LFSR:
+// tamano, estado y realimentacion en little-endian.
+std::unique_ptr<FuenteBits> crearLFSR(const uint8_t *clave9);
+std::unique_ptr<FuenteBits> crearGeffe(const uint8_t *clave27);
+std::unique_ptr<FuenteBits> crearBethPiper(const uint8_t *clave27);
+std::unique_ptr<FuenteBits> crearMasseyRueppel(const uint8_t *clave27);
+
+// Para los generadores bit a bit: 64 llamadas a next() por palabra
+template <class Generador>
+void empaquetarBits(Generador &generador, uint64_t *palabras, size_t cantidad) {
+    for (size_t w = 0; w < cantidad; ++w) {
+        uint64_t palabra = 0;
+        for (unsigned b = 0; b < 64; ++b) {
+            palabra |= static_cast<uint64_t>(generador.next() ? 1 : 0) << b;
+        }
+        palabras[w] = palabra;
+    }
+}
@@ -0,0 +1,40 @@
+// Pruebas estadisticas de NIST SP 800-22 rev. 1a sobre secuencias de bits
+// empaquetadas (bit i en el bit i % 64 de la palabra i / 64):
+//   frecuencia (2.1), rachas (2.3), espectral DFT (2.6), complejidad
+//   lineal (2.10), serie (2.11) y entropia aproximada (2.12).
+// Frecuencia y rachas cuentan palabras enteras con popcount, Berlekamp-
+// Massey trabaja con los polinomios empaquetados y serie y entropia
+// aproximada sacan todos sus tamanos de patron de una sola pasada.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct ResultadoPrueba {
+    std::string nombre;
+    std::string parametros;   // p. ej. "m=16"
+    std::vector<double> p;    // p-valores (serie da dos)
+    uint64_t bits = 0;        // bits usados realmente
+    bool superada = false;    // todos los p-valores >= kAlfa
+};
+
+namespace nist {
+
+constexpr double kAlfa = 0.01;
+
+// `bits` es multiplo de 64: se usan bits / 64 palabras de `datos`
+ResultadoPrueba frecuencia(const uint64_t *datos, uint64_t bits);
+ResultadoPrueba rachas(const uint64_t *datos, uint64_t bits);
+// Sobre los primeros min(bits, maxBits) bits redondeados a potencia de 2
+ResultadoPrueba espectral(const uint64_t *datos, uint64_t bits, uint64_t maxBits = 1 << 20);
+ResultadoPrueba complejidadLineal(const uint64_t *datos, uint64_t bits, unsigned M = 500);
+// m = 0 elige el mayor recomendado para `bits` (hasta 16 y 10)
+ResultadoPrueba serie(const uint64_t *datos, uint64_t bits, unsigned m = 0);
+ResultadoPrueba entropiaAproximada(const uint64_t *datos, uint64_t bits, unsigned m = 0);
+
+// Funcion gamma incompleta superior regularizada Q(a, x) (igamc de NIST)
+double igamc(double a, double x);
+
+} // namespace nist
@@ -0,0 +1,30 @@
+// Beth-Piper de Segunda/ejercicio6, en su propio espacio de nombres (ver
+// FuenteGeffe.cpp).
+#include "FuentesBits.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace segunda6 {
+#include "beth_piper_generator.h"
+} // namespace segunda6
+
+namespace {
+
+class FuenteBethPiper : public FuenteBits {
+public:
+    explicit FuenteBethPiper(const uint8_t *clave27) : generador_(clave27) {}
+
+    void generar(uint64_t *palabras, size_t cantidad) override {
+        empaquetarBits(generador_, palabras, cantidad);
+    }
+
+private:
+    segunda6::BethPiper generador_;
+};
+
+} // namespace
+
+std::unique_ptr<FuenteBits> crearBethPiper(const uint8_t *clave27) {
+    return std::unique_ptr<FuenteBits>(new FuenteBethPiper(clave27));
+}
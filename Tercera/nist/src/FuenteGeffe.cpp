@@ -0,0 +1,54 @@
+// LFSR y Geffe de Segunda/ejercicio4. El .h va dentro de un espacio de nombres
+// propio para que su LFSR no choque con los de los otros ejercicios.
+#include "FuentesBits.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace segunda4 {
+#include "geffe_generator.h"
+} // namespace segunda4
+
+namespace {
+
+class FuenteLFSR : public FuenteBits {
+public:
+    explicit FuenteLFSR(const uint8_t *clave9) {
+        const uint8_t tamano = clave9[0] & 0x1F;
+        lfsr_.init(leer32(clave9 + 1), leer32(clave9 + 5), tamano);
+    }
+
+    void generar(uint64_t *palabras, size_t cantidad) override {
+        empaquetarBits(lfsr_, palabras, cantidad);
+    }
+
+private:
+    segunda4::LFSR lfsr_;
+
+    static uint32_t leer32(const uint8_t *p) {
+        return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+               (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+};
+
+class FuenteGeffe : public FuenteBits {
+public:
+    explicit FuenteGeffe(const uint8_t *clave27) : geffe_(clave27) {}
+
+    void generar(uint64_t *palabras, size_t cantidad) override {
+        empaquetarBits(geffe_, palabras, cantidad);
+    }
+
+private:
+    segunda4::Geffe geffe_;
+};
+
+} // namespace
+
+std::unique_ptr<FuenteBits> crearLFSR(const uint8_t *clave9) {
+    return std::unique_ptr<FuenteBits>(new FuenteLFSR(clave9));
+}
+
+std::unique_ptr<FuenteBits> crearGeffe(const uint8_t *clave27) {
+    return std::unique_ptr<FuenteBits>(new FuenteGeffe(clave27));
+}
@@ -0,0 +1,30 @@
+// Massey-Rueppel de Segunda/ejercicio7, en su propio espacio de nombres (ver
+// FuenteGeffe.cpp).
+#include "FuentesBits.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace segunda7 {
+#include "massey_rueppel_generator.h"
+} // namespace segunda7
+
+namespace {
+
+class FuenteMassey : public FuenteBits {
+public:
+    explicit FuenteMassey(const uint8_t *clave27) : generador_(clave27) {}
+
+    void generar(uint64_t *palabras, size_t cantidad) override {
+        empaquetarBits(generador_, palabras, cantidad);
+    }
+
+private:
+    segunda7::MasseyRueppel generador_;
+};
+
+} // namespace
+
+std::unique_ptr<FuenteBits> crearMasseyRueppel(const uint8_t *clave27) {
+    return std::unique_ptr<FuenteBits>(new FuenteMassey(clave27));
+}
@@ -0,0 +1,158 @@
+#include "FuentesBits.h"
+
+#include "CifradorOFB.h"
+#include "hexcodec.h"
+#include "mi_random.h"
+
+#include <array>
+#include <cstdlib>
+
+namespace {
+
+constexpr size_t kLote = 4096;
+
+// Bytes de MiRandom: los 8 bits altos de cada estado, lo mismo que
+// (uint8_t)rand(0, 256)
+class FuenteMiRandom : public FuenteBytes {
+public:
+    explicit FuenteMiRandom(uint64_t semilla) : generador_(semilla) {}
+
+protected:
+    void bytes(uint8_t *salida, size_t longitud) override {
+        uint32_t estados[kLote];
+        while (longitud > 0) {
+            const size_t n = longitud < kLote ? longitud : kLote;
+            generador_.fillU32(estados, n);
+            for (size_t i = 0; i < n; ++i) {
+                salida[i] = static_cast<uint8_t>(estados[i] >> 23);
+            }
+            salida += n;
+            longitud -= n;
+        }
+    }
+
+private:
+    MiRandom generador_;
+};
+
+class FuenteOFB : public FuenteBytes {
+public:
+    FuenteOFB(const std::array<uint8_t, 16> &clave, const std::array<uint8_t, 16> &vi)
+        : cifrador_(clave, vi) {}
+
+protected:
+    void bytes(uint8_t *salida, size_t longitud) override {
+        // Bloques enteros directamente a la salida; lo que sobre de un bloque
+        // se guarda para la siguiente llamada
+        while (longitud > 0) {
+            if (usados_ < cifradorOFB::kBloque) {
+                *salida++ = resto_[usados_++];
+                --longitud;
+            } else if (longitud >= cifradorOFB::kBloque) {
+                const size_t bloques = longitud / cifradorOFB::kBloque;
+                cifrador_.generarBloques(salida, bloques);
+                salida += bloques * cifradorOFB::kBloque;
+                longitud -= bloques * cifradorOFB::kBloque;
+            } else {
+                cifrador_.generarBloques(resto_, 1);
+                usados_ = 0;
+            }
+        }
+    }
+
+private:
+    cifradorOFB cifrador_;
+    uint8_t resto_[cifradorOFB::kBloque] = {};
+    size_t usados_ = cifradorOFB::kBloque;
+};
+
+bool leerHex(const std::string &texto, uint8_t *salida, size_t bytes, std::string &error) {
+    size_t posicion = 0;
+    if (texto.size() == 2 * bytes && hexcodec::decode(texto.data(), texto.size(), salida, &posicion)) {
+        return true;
+    }
+    error = "se esperan " + std::to_string(2 * bytes) + " digitos hex";
+    if (texto.size() == 2 * bytes) {
+        error += " (error en la posicion " + std::to_string(posicion) + ")";
+    }
+    return false;
+}
+
+} // namespace
+
+void FuenteBytes::generar(uint64_t *palabras, size_t cantidad) {
+    uint8_t octetos[8 * 512];
+    while (cantidad > 0) {
+        const size_t n = cantidad < 512 ? cantidad : 512;
+        bytes(octetos, 8 * n);
+        for (size_t w = 0; w < n; ++w) {
+            uint64_t palabra = 0;
+            for (unsigned k = 0; k < 8; ++k) {
+                // bit mas significativo de cada byte primero
+                const uint8_t byte = octetos[8 * w + k];
+                for (unsigned b = 0; b < 8; ++b) {
+                    palabra |= static_cast<uint64_t>((byte >> (7 - b)) & 1) << (8 * k + b);
+                }
+            }
+            palabras[w] = palabra;
+        }
+        palabras += n;
+        cantidad -= n;
+    }
+}
+
+const std::vector<GeneradorDisponible> &generadoresDisponibles() {
+    // Claves de los ejemplos: LFSRKey {8, 0x12345678, 0x1D}, {10, 0xABCDEF01,
+    // 0x205}, {11, 0x98765432, 0x403} de Segunda y la clave/VI de Tercera/ejercicio1
+    static const std::vector<GeneradorDisponible> lista = {
+        {"mirandom", "semilla decimal", "903699"},
+        {"lfsr", "9 bytes hex (tamano, estado, realimentacion)", "08785634121D000000"},
+        {"geffe", "27 bytes hex (3 LFSR)", "08785634121D0000000A01EFCDAB050200000B3254769803040000"},
+        {"bethpiper", "27 bytes hex (3 LFSR)", "08785634121D0000000A01EFCDAB050200000B3254769803040000"},
+        {"massey", "27 bytes hex (3 LFSR)", "08785634121D0000000A01EFCDAB050200000B3254769803040000"},
+        {"ofb", "clave:vi (16 + 16 bytes hex)",
+         "00112233445566778899AABBCCDDEEFF:0F1E2D3C4B5A69788796A5B4C3D2E1F0"},
+    };
+    return lista;
+}
+
+std::unique_ptr<FuenteBits> crearFuente(const std::string &generador, const std::string &clave,
+                                        std::string &error) {
+    if (generador == "mirandom") {
+        char *fin = nullptr;
+        const uint64_t semilla = strtoull(clave.c_str(), &fin, 10);
+        if (clave.empty() || *fin != '\0') {
+            error = "semilla no valida";
+            return nullptr;
+        }
+        return std::unique_ptr<FuenteBits>(new FuenteMiRandom(semilla));
+    }
+    if (generador == "ofb") {
+        std::array<uint8_t, 16> k{};
+        std::array<uint8_t, 16> vi{};
+        const size_t separador = clave.find(':');
+        if (separador == std::string::npos || !leerHex(clave.substr(0, separador), k.data(), 16, error) ||
+            !leerHex(clave.substr(separador + 1), vi.data(), 16, error)) {
+            if (error.empty()) {
+                error = "se espera clave:vi";
+            }
+            return nullptr;
+        }
+        return std::unique_ptr<FuenteBits>(new FuenteOFB(k, vi));
+    }
+    if (generador == "lfsr") {
+        uint8_t bytes[9];
+        return leerHex(clave, bytes, sizeof(bytes), error) ? crearLFSR(bytes) : nullptr;
+    }
+    if (generador == "geffe" || generador == "bethpiper" || generador == "massey") {
+        uint8_t bytes[27];
+        if (!leerHex(clave, bytes, sizeof(bytes), error)) {
+            return nullptr;
+        }
+        return generador == "geffe" ? crearGeffe(bytes)
+             : generador == "bethpiper" ? crearBethPiper(bytes)
+             : crearMasseyRueppel(bytes);
+    }
+    error = "generador desconocido";
+    return nullptr;
+}
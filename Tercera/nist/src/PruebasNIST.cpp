@@ -0,0 +1,352 @@
+#include "PruebasNIST.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+
+namespace {
+
+inline unsigned bit(const uint64_t *datos, uint64_t i) {
+    return static_cast<unsigned>((datos[i / 64] >> (i % 64)) & 1);
+}
+
+// Palabra w con los bits que pasan de `bits` a cero
+inline uint64_t palabra(const uint64_t *datos, uint64_t bits, uint64_t w) {
+    const uint64_t resto = bits - 64 * w;
+    return resto >= 64 ? datos[w] : datos[w] & ((1ULL << resto) - 1);
+}
+
+uint64_t contarUnos(const uint64_t *datos, uint64_t bits) {
+    uint64_t unos = 0;
+    for (uint64_t w = 0; w < (bits + 63) / 64; ++w) {
+        unos += static_cast<uint64_t>(__builtin_popcountll(palabra(datos, bits, w)));
+    }
+    return unos;
+}
+
+unsigned log2Entero(uint64_t x) {
+    return x == 0 ? 0 : 63u - static_cast<unsigned>(__builtin_clzll(x));
+}
+
+ResultadoPrueba resultado(const char *nombre, uint64_t bits, std::vector<double> p,
+                          const std::string &parametros = "") {
+    ResultadoPrueba r;
+    r.nombre = nombre;
+    r.parametros = parametros;
+    r.bits = bits;
+    r.p = std::move(p);
+    r.superada = !r.p.empty();
+    for (double valor : r.p) {
+        r.superada = r.superada && valor >= nist::kAlfa;
+    }
+    return r;
+}
+
+std::string formato(const char *plantilla, unsigned valor) {
+    char texto[32];
+    snprintf(texto, sizeof(texto), plantilla, valor);
+    return texto;
+}
+
+// Apariciones de cada patron de m bits solapados, dando la vuelta al final
+// (el primer bit del patron es el mas significativo)
+std::vector<uint64_t> contarPatrones(const uint64_t *datos, uint64_t bits, unsigned m) {
+    std::vector<uint64_t> cuentas(size_t(1) << m, 0);
+    const uint64_t mascara = (uint64_t(1) << m) - 1;
+    uint64_t ventana = 0;
+    for (unsigned i = 0; i + 1 < m; ++i) {
+        ventana = (ventana << 1) | bit(datos, i % bits);
+    }
+    for (uint64_t i = m - 1; i < bits + m - 1; ++i) {
+        ventana = ((ventana << 1) | bit(datos, i < bits ? i : i - bits)) & mascara;
+        ++cuentas[ventana];
+    }
+    return cuentas;
+}
+
+// Cuentas de patrones de k < m bits a partir de las de m (son sus prefijos)
+std::vector<uint64_t> reducirPatrones(const std::vector<uint64_t> &cuentas, unsigned m, unsigned k) {
+    std::vector<uint64_t> reducidas(size_t(1) << k, 0);
+    for (size_t v = 0; v < cuentas.size(); ++v) {
+        reducidas[v >> (m - k)] += cuentas[v];
+    }
+    return reducidas;
+}
+
+double psi2(const std::vector<uint64_t> &cuentas, unsigned m, uint64_t bits) {
+    if (m == 0) {
+        return 0.0;
+    }
+    double suma = 0.0;
+    for (uint64_t c : cuentas) {
+        suma += static_cast<double>(c) * static_cast<double>(c);
+    }
+    return std::ldexp(suma, static_cast<int>(m)) / static_cast<double>(bits) - static_cast<double>(bits);
+}
+
+double phi(const std::vector<uint64_t> &cuentas, uint64_t bits) {
+    double suma = 0.0;
+    for (uint64_t c : cuentas) {
+        if (c != 0) {
+            const double frecuencia = static_cast<double>(c) / static_cast<double>(bits);
+            suma += frecuencia * std::log(frecuencia);
+        }
+    }
+    return suma;
+}
+
+// FFT iterativa radix 2 (tamano potencia de 2)
+void fft(std::vector<std::complex<double>> &x) {
+    const size_t n = x.size();
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t b = n >> 1;
+        for (; j & b; b >>= 1) {
+            j ^= b;
+        }
+        j ^= b;
+        if (i < j) {
+            std::swap(x[i], x[j]);
+        }
+    }
+    std::vector<std::complex<double>> raices(n / 2);
+    for (size_t k = 0; k < n / 2; ++k) {
+        const double angulo = -2.0 * M_PI * static_cast<double>(k) / static_cast<double>(n);
+        raices[k] = std::complex<double>(std::cos(angulo), std::sin(angulo));
+    }
+    for (size_t largo = 2; largo <= n; largo <<= 1) {
+        const size_t paso = n / largo;
+        for (size_t i = 0; i < n; i += largo) {
+            for (size_t k = 0; k < largo / 2; ++k) {
+                const std::complex<double> t = raices[k * paso] * x[i + k + largo / 2];
+                x[i + k + largo / 2] = x[i + k] - t;
+                x[i + k] += t;
+            }
+        }
+    }
+}
+
+// Berlekamp-Massey con los polinomios empaquetados: la discrepancia es la
+// paridad de C & R, con R los ultimos bits al reves (bit i = s_{N-i})
+class BerlekampMassey {
+public:
+    explicit BerlekampMassey(unsigned M)
+        : palabras_(M / 64 + 2), c_(palabras_), b_(palabras_), r_(palabras_), t_(palabras_) {}
+
+    unsigned complejidad(const uint64_t *datos, uint64_t inicio, unsigned M) {
+        std::fill(c_.begin(), c_.end(), 0);
+        std::fill(b_.begin(), b_.end(), 0);
+        std::fill(r_.begin(), r_.end(), 0);
+        c_[0] = 1;
+        b_[0] = 1;
+        unsigned L = 0;
+        int m = -1;
+        for (unsigned N = 0; N < M; ++N) {
+            for (size_t w = palabras_ - 1; w > 0; --w) {
+                r_[w] = (r_[w] << 1) | (r_[w - 1] >> 63);
+            }
+            r_[0] = (r_[0] << 1) | bit(datos, inicio + N);
+
+            unsigned d = 0;
+            for (size_t w = 0; w < palabras_; ++w) {
+                d ^= static_cast<unsigned>(__builtin_popcountll(c_[w] & r_[w]));
+            }
+            if ((d & 1) == 0) {
+                continue;
+            }
+            t_ = c_;
+            // C ^= B * x^(N - m)
+            const unsigned desplazamiento = N - static_cast<unsigned>(m);
+            const size_t enPalabras = desplazamiento / 64;
+            const unsigned enBits = desplazamiento % 64;
+            for (size_t w = palabras_ - 1; w + 1 > enPalabras; --w) {
+                uint64_t v = b_[w - enPalabras] << enBits;
+                if (enBits != 0 && w > enPalabras) {
+                    v |= b_[w - enPalabras - 1] >> (64 - enBits);
+                }
+                c_[w] ^= v;
+            }
+            if (2 * L <= N) {
+                L = N + 1 - L;
+                m = static_cast<int>(N);
+                b_ = t_;
+            }
+        }
+        return L;
+    }
+
+private:
+    size_t palabras_;
+    std::vector<uint64_t> c_, b_, r_, t_;
+};
+
+} // namespace
+
+namespace nist {
+
+ResultadoPrueba frecuencia(const uint64_t *datos, uint64_t bits) {
+    const double n = static_cast<double>(bits);
+    const double suma = 2.0 * static_cast<double>(contarUnos(datos, bits)) - n;
+    const double sObs = std::fabs(suma) / std::sqrt(n);
+    return resultado("frecuencia", bits, {std::erfc(sObs / std::sqrt(2.0))});
+}
+
+ResultadoPrueba rachas(const uint64_t *datos, uint64_t bits) {
+    const double n = static_cast<double>(bits);
+    const double pi = static_cast<double>(contarUnos(datos, bits)) / n;
+    // Requisito previo: si la frecuencia ya falla, p = 0
+    if (std::fabs(pi - 0.5) >= 2.0 / std::sqrt(n)) {
+        return resultado("rachas", bits, {0.0});
+    }
+    // Cambios entre bits consecutivos: bit k de w ^ (w >> 1 con el primero de la siguiente)
+    uint64_t cambios = 0;
+    const uint64_t palabras = (bits + 63) / 64;
+    for (uint64_t w = 0; w < palabras; ++w) {
+        const uint64_t siguiente = w + 1 < palabras ? datos[w + 1] & 1 : 0;
+        uint64_t diferencias = datos[w] ^ ((datos[w] >> 1) | (siguiente << 63));
+        const uint64_t validos = std::min<uint64_t>(64, bits - 1 - 64 * w);
+        if (validos < 64) {
+            diferencias &= (1ULL << validos) - 1;
+        }
+        cambios += static_cast<uint64_t>(__builtin_popcountll(diferencias));
+    }
+    const double v = static_cast<double>(cambios + 1);
+    const double p = std::erfc(std::fabs(v - 2.0 * n * pi * (1.0 - pi)) /
+                               (2.0 * std::sqrt(2.0 * n) * pi * (1.0 - pi)));
+    return resultado("rachas", bits, {p});
+}
+
+ResultadoPrueba espectral(const uint64_t *datos, uint64_t bits, uint64_t maxBits) {
+    const uint64_t n = uint64_t(1) << log2Entero(std::min(bits, maxBits));
+    std::vector<std::complex<double>> x(n);
+    for (uint64_t i = 0; i < n; ++i) {
+        x[i] = bit(datos, i) ? 1.0 : -1.0;
+    }
+    fft(x);
+    const double nd = static_cast<double>(n);
+    const double umbral = std::sqrt(std::log(1.0 / 0.05) * nd);
+    uint64_t debajo = 0;
+    for (uint64_t j = 0; j < n / 2; ++j) {
+        debajo += std::abs(x[j]) < umbral ? 1 : 0;
+    }
+    const double esperados = 0.95 * nd / 2.0;
+    const double d = (static_cast<double>(debajo) - esperados) / std::sqrt(nd * 0.95 * 0.05 / 4.0);
+    return resultado("espectral", n, {std::erfc(std::fabs(d) / std::sqrt(2.0))});
+}
+
+ResultadoPrueba complejidadLineal(const uint64_t *datos, uint64_t bits, unsigned M) {
+    const uint64_t bloques = bits / M;
+    const std::string parametros = formato("M=%u", M);
+    if (bloques == 0) {
+        return resultado("complejidad_lineal", bits, {}, parametros);
+    }
+    static const double kPi[7] = {0.01047, 0.03125, 0.12500, 0.50000, 0.25000, 0.06250, 0.020833};
+    const double signo = (M % 2 == 0) ? 1.0 : -1.0;
+    const double media = M / 2.0 + (9.0 - signo) / 36.0 - (M / 3.0 + 2.0 / 9.0) / std::ldexp(1.0, static_cast<int>(M));
+
+    uint64_t clases[7] = {};
+    BerlekampMassey bm(M);
+    for (uint64_t b = 0; b < bloques; ++b) {
+        const double L = bm.complejidad(datos, b * M, M);
+        const double t = signo * (L - media) + 2.0 / 9.0;
+        const int clase = t <= -2.5 ? 0 : t <= -1.5 ? 1 : t <= -0.5 ? 2 : t <= 0.5 ? 3 : t <= 1.5 ? 4 : t <= 2.5 ? 5 : 6;
+        ++clases[clase];
+    }
+    double chi2 = 0.0;
+    for (int i = 0; i < 7; ++i) {
+        const double esperado = static_cast<double>(bloques) * kPi[i];
+        chi2 += (static_cast<double>(clases[i]) - esperado) * (static_cast<double>(clases[i]) - esperado) / esperado;
+    }
+    return resultado("complejidad_lineal", bloques * M, {igamc(3.0, chi2 / 2.0)}, parametros);
+}
+
+ResultadoPrueba serie(const uint64_t *datos, uint64_t bits, unsigned m) {
+    if (m == 0) {
+        m = std::min(16u, std::max(2u, log2Entero(bits) - 3));
+    }
+    const std::vector<uint64_t> cuentas = contarPatrones(datos, bits, m);
+    const double psiM = psi2(cuentas, m, bits);
+    const double psiM1 = psi2(reducirPatrones(cuentas, m, m - 1), m - 1, bits);
+    const double psiM2 = m >= 2 ? psi2(reducirPatrones(cuentas, m, m - 2), m - 2, bits) : 0.0;
+    const double delta1 = psiM - psiM1;
+    const double delta2 = psiM - 2.0 * psiM1 + psiM2;
+    return resultado("serie", bits,
+                     {igamc(std::ldexp(1.0, static_cast<int>(m) - 2), delta1 / 2.0),
+                      igamc(std::ldexp(1.0, static_cast<int>(m) - 3), delta2 / 2.0)},
+                     formato("m=%u", m));
+}
+
+ResultadoPrueba entropiaAproximada(const uint64_t *datos, uint64_t bits, unsigned m) {
+    if (m == 0) {
+        m = std::min(10u, std::max(2u, log2Entero(bits) - 6));
+    }
+    const std::vector<uint64_t> cuentas = contarPatrones(datos, bits, m + 1);
+    const double apen = phi(reducirPatrones(cuentas, m + 1, m), bits) - phi(cuentas, bits);
+    const double chi2 = 2.0 * static_cast<double>(bits) * (std::log(2.0) - apen);
+    return resultado("entropia_aproximada", bits,
+                     {igamc(std::ldexp(1.0, static_cast<int>(m) - 1), chi2 / 2.0)},
+                     formato("m=%u", m));
+}
+
+// Como en cephes (la que usa el codigo de referencia de NIST): serie para
+// x < a, fraccion continua en otro caso
+double igamc(double a, double x) {
+    constexpr double kEpsilon = 1.11022302462515654042e-16;
+    constexpr double kGrande = 4503599627370496.0;
+    constexpr double kInversoGrande = 2.22044604925031308085e-16;
+    if (x <= 0.0 || a <= 0.0) {
+        return 1.0;
+    }
+    const double ax = a * std::log(x) - x - std::lgamma(a);
+    if (ax < -709.78271289338399) {
+        return x < a ? 1.0 : 0.0;
+    }
+    const double factor = std::exp(ax);
+
+    if (x < 1.0 || x < a) {
+        double r = a;
+        double c = 1.0;
+        double suma = 1.0;
+        do {
+            r += 1.0;
+            c *= x / r;
+            suma += c;
+        } while (c / suma > kEpsilon);
+        return 1.0 - suma * factor / a;
+    }
+
+    double y = 1.0 - a;
+    double z = x + y + 1.0;
+    double c = 0.0;
+    double pkm2 = 1.0, qkm2 = x, pkm1 = x + 1.0, qkm1 = z * x;
+    double fraccion = pkm1 / qkm1;
+    double t = 1.0;
+    do {
+        c += 1.0;
+        y += 1.0;
+        z += 2.0;
+        const double yc = y * c;
+        const double pk = pkm1 * z - pkm2 * yc;
+        const double qk = qkm1 * z - qkm2 * yc;
+        if (qk != 0.0) {
+            const double r = pk / qk;
+            t = std::fabs((fraccion - r) / r);
+            fraccion = r;
+        } else {
+            t = 1.0;
+        }
+        pkm2 = pkm1;
+        pkm1 = pk;
+        qkm2 = qkm1;
+        qkm1 = qk;
+        if (std::fabs(pk) > kGrande) {
+            pkm2 *= kInversoGrande;
+            pkm1 *= kInversoGrande;
+            qkm2 *= kInversoGrande;
+            qkm1 *= kInversoGrande;
+        }
+    } while (t > kEpsilon);
+    return fraccion * factor;
+}
+
+} // namespace nist
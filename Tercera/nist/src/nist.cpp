@@ -0,0 +1,267 @@
+/* Host tool: bateria de pruebas NIST SP 800-22 para los generadores de las
+ * practicas. Primero genera en paralelo la secuencia de cada generador
+ * (empaquetada, bits / 8 bytes por generador) y despues reparte las
+ * parejas (generador, prueba) entre los hilos. Escribe un JSON por
+ * generador y clave y una tabla resumen por la salida estandar.
+ *
+ * Build (from Tercera/nist):
+ *   g++ -std=c++17 -O2 -pthread -Iinclude -I../ejercicio1/include \
+ *       -I../lib/hexcodec -I../../Segunda/ejercicio1/src \
+ *       -I../../Segunda/ejercicio4/src -I../../Segunda/ejercicio6/src \
+ *       -I../../Segunda/ejercicio7/src src/nist.cpp src/PruebasNIST.cpp \
+ *       src/FuentesBits.cpp src/FuenteGeffe.cpp src/FuenteBethPiper.cpp \
+ *       src/FuenteMassey.cpp ../ejercicio1/src/CifradorOFB.cpp \
+ *       ../lib/hexcodec/hexcodec.cpp -o nist
+ *
+ * Usage: nist [-n bits] [-h hilos] [-o directorio] [generador[:clave] ...]
+ *   bits admite los sufijos k, M y G (por defecto 1M); sin generadores se
+ *   prueban todos con las claves de los ejemplos. "nist -l" los lista.
+ *   Ej.: nist -n 64M -o informes mirandom:12345 geffe ofb
+ */
+
+#include "FuentesBits.h"
+#include "PruebasNIST.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Prueba {
+    const char *nombre;
+    std::function<ResultadoPrueba(const uint64_t *, uint64_t)> ejecutar;
+};
+
+// Las mas lentas primero para que no queden solas al final
+const std::vector<Prueba> &pruebas() {
+    static const std::vector<Prueba> lista = {
+        {"complejidad_lineal", [](const uint64_t *d, uint64_t n) { return nist::complejidadLineal(d, n); }},
+        {"serie", [](const uint64_t *d, uint64_t n) { return nist::serie(d, n); }},
+        {"entropia_aproximada", [](const uint64_t *d, uint64_t n) { return nist::entropiaAproximada(d, n); }},
+        {"espectral", [](const uint64_t *d, uint64_t n) { return nist::espectral(d, n); }},
+        {"rachas", [](const uint64_t *d, uint64_t n) { return nist::rachas(d, n); }},
+        {"frecuencia", [](const uint64_t *d, uint64_t n) { return nist::frecuencia(d, n); }},
+    };
+    return lista;
+}
+
+struct Trabajo {
+    std::string generador;
+    std::string clave;
+    std::unique_ptr<FuenteBits> fuente;
+    std::vector<uint64_t> datos;
+    double segundosGenerar = 0.0;
+    std::vector<ResultadoPrueba> resultados;
+    std::vector<double> segundosPrueba;
+};
+
+double segundosDesde(std::chrono::steady_clock::time_point inicio) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+}
+
+// Reparte los indices 0..total-1 entre `hilos` hilos
+void enParalelo(size_t total, unsigned hilos, const std::function<void(size_t)> &tarea) {
+    std::atomic<size_t> siguiente{0};
+    std::vector<std::thread> grupo;
+    for (unsigned h = 0; h < std::min<size_t>(hilos, total); ++h) {
+        grupo.emplace_back([&] {
+            for (size_t i = siguiente++; i < total; i = siguiente++) {
+                tarea(i);
+            }
+        });
+    }
+    for (std::thread &t : grupo) {
+        t.join();
+    }
+}
+
+bool leerBits(const char *texto, uint64_t &bits) {
+    char *fin = nullptr;
+    bits = strtoull(texto, &fin, 10);
+    switch (*fin) {
+    case 'k': bits <<= 10; ++fin; break;
+    case 'M': bits <<= 20; ++fin; break;
+    case 'G': bits <<= 30; ++fin; break;
+    default: break;
+    }
+    return fin != texto && *fin == '\0' && bits >= 64;
+}
+
+std::string escaparJSON(const std::string &texto) {
+    std::string salida;
+    for (char c : texto) {
+        if (c == '"' || c == '\\') {
+            salida += '\\';
+        }
+        salida += c;
+    }
+    return salida;
+}
+
+std::string nombreFichero(const Trabajo &t) {
+    std::string nombre = t.generador + "_" + t.clave;
+    for (char &c : nombre) {
+        if (!isalnum(static_cast<unsigned char>(c)) && c != '_') {
+            c = '-';
+        }
+    }
+    return nombre + ".json";
+}
+
+bool escribirInforme(const Trabajo &t, const std::string &directorio) {
+    const std::string ruta = directorio + "/" + nombreFichero(t);
+    FILE *f = fopen(ruta.c_str(), "w");
+    if (!f) {
+        fprintf(stderr, "no se puede escribir %s\n", ruta.c_str());
+        return false;
+    }
+    size_t superadas = 0;
+    fprintf(f, "{\n  \"generador\": \"%s\",\n  \"clave\": \"%s\",\n", escaparJSON(t.generador).c_str(),
+            escaparJSON(t.clave).c_str());
+    fprintf(f, "  \"bits\": %llu,\n  \"alfa\": %g,\n  \"segundos_generar\": %.3f,\n  \"pruebas\": [\n",
+            static_cast<unsigned long long>(64 * t.datos.size()), nist::kAlfa, t.segundosGenerar);
+    for (size_t i = 0; i < t.resultados.size(); ++i) {
+        const ResultadoPrueba &r = t.resultados[i];
+        superadas += r.superada ? 1 : 0;
+        fprintf(f, "    {\"nombre\": \"%s\", \"parametros\": \"%s\", \"bits\": %llu, \"p\": [", r.nombre.c_str(),
+                escaparJSON(r.parametros).c_str(), static_cast<unsigned long long>(r.bits));
+        for (size_t k = 0; k < r.p.size(); ++k) {
+            fprintf(f, "%s%.6g", k ? ", " : "", r.p[k]);
+        }
+        fprintf(f, "], \"superada\": %s, \"segundos\": %.3f}%s\n", r.superada ? "true" : "false",
+                t.segundosPrueba[i], i + 1 < t.resultados.size() ? "," : "");
+    }
+    fprintf(f, "  ],\n  \"superadas\": %zu,\n  \"total\": %zu\n}\n", superadas, t.resultados.size());
+    fclose(f);
+    return true;
+}
+
+void uso(const char *programa) {
+    fprintf(stderr, "uso: %s [-n bits] [-h hilos] [-o directorio] [generador[:clave] ...]\n", programa);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    uint64_t bits = 1 << 20;
+    unsigned hilos = std::max(1u, std::thread::hardware_concurrency());
+    std::string directorio = ".";
+    std::vector<Trabajo> trabajos;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "-l") {
+            for (const GeneradorDisponible &g : generadoresDisponibles()) {
+                printf("%-10s %-45s %s\n", g.nombre, g.clave, g.porDefecto);
+            }
+            return 0;
+        }
+        if ((arg == "-n" || arg == "-h" || arg == "-o") && i + 1 < argc) {
+            const char *valor = argv[++i];
+            if (arg == "-n" && !leerBits(valor, bits)) {
+                fprintf(stderr, "numero de bits no valido: %s\n", valor);
+                return 1;
+            }
+            if (arg == "-h") {
+                hilos = static_cast<unsigned>(std::max(1, atoi(valor)));
+            }
+            if (arg == "-o") {
+                directorio = valor;
+            }
+            continue;
+        }
+        if (arg[0] == '-') {
+            uso(argv[0]);
+            return 1;
+        }
+        // generador[:clave]; la clave de OFB lleva a su vez "clave:vi"
+        Trabajo t;
+        const size_t separador = arg.find(':');
+        t.generador = arg.substr(0, separador);
+        if (separador != std::string::npos) {
+            t.clave = arg.substr(separador + 1);
+        }
+        trabajos.push_back(std::move(t));
+    }
+    if (trabajos.empty()) {
+        for (const GeneradorDisponible &g : generadoresDisponibles()) {
+            Trabajo t;
+            t.generador = g.nombre;
+            trabajos.push_back(std::move(t));
+        }
+    }
+    for (Trabajo &t : trabajos) {
+        if (t.clave.empty()) {
+            for (const GeneradorDisponible &g : generadoresDisponibles()) {
+                if (t.generador == g.nombre) {
+                    t.clave = g.porDefecto;
+                }
+            }
+        }
+        std::string error;
+        t.fuente = crearFuente(t.generador, t.clave, error);
+        if (!t.fuente) {
+            fprintf(stderr, "%s: %s\n", t.generador.c_str(), error.c_str());
+            return 1;
+        }
+    }
+
+    const size_t palabras = (bits + 63) / 64;
+    printf("%zu generadores, %llu bits cada uno, %u hilos\n", trabajos.size(),
+           static_cast<unsigned long long>(64 * palabras), hilos);
+
+    // 1) Secuencias: cada generador es secuencial, se reparten entre hilos
+    auto inicio = std::chrono::steady_clock::now();
+    enParalelo(trabajos.size(), hilos, [&](size_t i) {
+        Trabajo &t = trabajos[i];
+        const auto inicioGenerar = std::chrono::steady_clock::now();
+        t.datos.resize(palabras);
+        t.fuente->generar(t.datos.data(), palabras);
+        t.segundosGenerar = segundosDesde(inicioGenerar);
+    });
+    printf("generacion: %.2f s\n", segundosDesde(inicio));
+
+    // 2) Pruebas: una tarea por pareja (generador, prueba)
+    const std::vector<Prueba> &lista = pruebas();
+    for (Trabajo &t : trabajos) {
+        t.resultados.resize(lista.size());
+        t.segundosPrueba.resize(lista.size());
+    }
+    inicio = std::chrono::steady_clock::now();
+    enParalelo(trabajos.size() * lista.size(), hilos, [&](size_t tarea) {
+        // La prueba va en el indice mas lento: primero todas las lentas
+        Trabajo &t = trabajos[tarea % trabajos.size()];
+        const size_t p = tarea / trabajos.size();
+        const auto inicioPrueba = std::chrono::steady_clock::now();
+        t.resultados[p] = lista[p].ejecutar(t.datos.data(), 64 * palabras);
+        t.segundosPrueba[p] = segundosDesde(inicioPrueba);
+    });
+    printf("pruebas: %.2f s\n\n", segundosDesde(inicio));
+
+    printf("%-10s", "");
+    for (const Prueba &p : lista) {
+        printf(" %-20s", p.nombre);
+    }
+    printf("\n");
+    bool escritos = true;
+    for (const Trabajo &t : trabajos) {
+        printf("%-10s", t.generador.c_str());
+        for (const ResultadoPrueba &r : t.resultados) {
+            // se muestra el menor p-valor de la prueba
+            const double p = r.p.empty() ? 0.0 : *std::min_element(r.p.begin(), r.p.end());
+            printf(" %-5s %-14.6f", r.superada ? "ok" : "FALLA", p);
+        }
+        printf("\n");
+        escritos = escribirInforme(t, directorio) && escritos;
+    }
+    return escritos ? 0 : 1;
+}